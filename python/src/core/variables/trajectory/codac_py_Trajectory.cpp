@@ -10,10 +10,12 @@
  */
 
 #include <sstream>
+#include <cstring>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "codac_type_caster.h"
 
 #include "codac_Trajectory.h"
@@ -68,8 +70,19 @@ void export_Trajectory(py::module& m)
 
   // Accessing values
 
-    .def("sampled_map", &Trajectory::sampled_map,
-      TRAJECTORY_CONSTMAPDOUBLEDOUBLE_SAMPLED_MAP)
+    .def("sampled_map", [](const Trajectory& x) { return x.samples().to_map(); },
+      TRAJECTORY_CONSTTRAJECTORYSAMPLES_SAMPLED_MAP)
+
+    .def("samples", [](const Trajectory& x)
+      {
+        const TrajectorySamples& s = x.samples();
+        py::array_t<double> a({ (py::ssize_t)s.size(), (py::ssize_t)2 });
+        if(!s.empty()) // contiguous pairs (t,y), copied at once
+          memcpy(a.mutable_data(), s.data(), s.size()*sizeof(TrajectorySamples::value_type));
+        return a;
+      },
+      "Returns a copy of the samples (t,y) of the trajectory, as a numpy array of shape (n,2).\n"
+      "The array is independent from the trajectory: it is not updated by later changes of its values.")
 
     .def("tfunction", &Trajectory::tfunction,
       TRAJECTORY_CONSTTFUNCTION_TFUNCTION,
@@ -107,6 +120,10 @@ void export_Trajectory(py::module& m)
       TRAJECTORY_VOID_SET_DOUBLE_DOUBLE,
       "y"_a, "t"_a)
 
+    .def("append", &Trajectory::append,
+      TRAJECTORY_TRAJECTORY_APPEND_VECTORDOUBLE_VECTORDOUBLE,
+      "v_t"_a, "v_y"_a)
+
     .def("truncate_tdomain", &Trajectory::truncate_tdomain,
       TRAJECTORY_TRAJECTORY_TRUNCATE_TDOMAIN_INTERVAL,
       "tdomain"_a)
@@ -46,32 +46,30 @@ TrajectoryVector* create_trajectoryvector_from_list(py::list& lst)
   return instance; // todo: manage delete of pointer
 }
 
-TrajectoryVector* create_trajectoryvector_from_arrays(py::array_t<double>& lst_t, py::array_t<double>& lst_x)
+TrajectoryVector* create_trajectoryvector_from_arrays(
+  py::array_t<double,py::array::c_style|py::array::forcecast>& lst_t,
+  py::array_t<double,py::array::c_style|py::array::forcecast>& lst_x)
 {
   if(lst_t.size() < 1 || lst_x.size() < 1)
     throw std::invalid_argument("Empty Trajectory list");
 
-  list<Vector> std_lst_x;
+  // The arrays are read in place (no copy if already contiguous),
+  // each component being appended in one pass on the shared time keys
+  const double *ptr_t = lst_t.data(), *ptr_x = lst_x.data();
+  const size_t nb_t = lst_t.size();
 
-  py::buffer_info info = lst_x.request();
-  auto ptr = static_cast<double*>(info.ptr);
+  assert(lst_x.size() % nb_t == 0);
+  const int n = lst_x.size() / nb_t;
 
-  int nb_values = 1;
-  for(auto r : info.shape)
-    nb_values *= r;
-  
-  assert(nb_values % lst_t.size() == 0);
-  int n = nb_values / lst_t.size();
-
-  for(int i = 0 ; i < nb_values ; i+=n)
+  vector<double> v_t(ptr_t, ptr_t + nb_t), v_x(nb_t);
+  TrajectoryVector *instance = new TrajectoryVector(n);
+  for(int i = 0 ; i < n ; i++)
   {
-    Vector x(n);
-    for(int k = 0 ; k < n ; k++)
-      x[k] = *ptr++;
-    std_lst_x.push_back(x);
+    for(size_t k = 0 ; k < nb_t ; k++)
+      v_x[k] = ptr_x[k*n + i];
+    (*instance)[i].append(v_t, v_x);
   }
 
-  TrajectoryVector *instance = new TrajectoryVector(lst_t.cast<std::list<double> >(), std_lst_x);
   return instance; // todo: manage delete of pointer
 }
 
@@ -179,6 +177,10 @@ void export_TrajectoryVector(py::module& m)
       TRAJECTORYVECTOR_VOID_SET_VECTOR_DOUBLE,
       "y"_a, "t"_a)
 
+    .def("append", &TrajectoryVector::append,
+      TRAJECTORYVECTOR_TRAJECTORYVECTOR_APPEND_VECTORDOUBLE_VECTORVECTOR,
+      "v_t"_a, "v_y"_a)
+
     .def("truncate_tdomain", &TrajectoryVector::truncate_tdomain,
       TRAJECTORYVECTOR_TRAJECTORYVECTOR_TRUNCATE_TDOMAIN_INTERVAL,
       "domain"_a)
@@ -40,7 +40,7 @@ namespace codac2
         continue;
 
       // su is a SliceVector of the TubeVector u:
-      const shared_ptr<Slice<IntervalVector>> su = static_pointer_cast<Slice<IntervalVector>>(sx.tslice().slices().at(&u));
+      const Slice<IntervalVector>& su = static_cast<const Slice<IntervalVector>&>(*sx.tslice().slice(u));
       
       //const double dt = sx.t0_tf().diam();
 
@@ -88,8 +88,8 @@ namespace codac2
       {
         if((*it).is_gate()) continue;
         if((*it).t0_tf().is_unbounded()) continue;
-        const shared_ptr<Slice<Interval>> su = static_pointer_cast<Slice<Interval>>((*it).tslice().slices().at(&u));
-        contract(*it, *su, TimePropag::FORWARD, compute_envelopes && !(t_propa & TimePropag::BACKWARD));
+        const Slice<Interval>& su = static_cast<const Slice<Interval>&>(*(*it).tslice().slice(u));
+        contract(*it, su, TimePropag::FORWARD, compute_envelopes && !(t_propa & TimePropag::BACKWARD));
         // Envelopes are contracted in the bwd iteration if selected
       }
 
@@ -98,8 +98,8 @@ namespace codac2
       {
         if((*it).is_gate()) continue;
         if((*it).t0_tf().is_unbounded()) continue;
-        const shared_ptr<Slice<Interval>> su = static_pointer_cast<Slice<Interval>>((*it).tslice().slices().at(&u));
-        contract(*it, *su, TimePropag::BACKWARD, compute_envelopes);
+        const Slice<Interval>& su = static_cast<const Slice<Interval>&>(*(*it).tslice().slice(u));
+        contract(*it, su, TimePropag::BACKWARD, compute_envelopes);
       }
   }
 
@@ -33,18 +33,18 @@ namespace codac2
     return *_it_tslice;
   }
 
-  const std::shared_ptr<AbstractSlice> AbstractSlice::prev_abstract_slice_ptr() const
+  const AbstractSlice* AbstractSlice::prev_abstract_slice_ptr() const
   {
-    if(&(*_tubevector.first_abstract_slice_ptr()) == this)
+    if(_it_tslice == _tubevector.tdomain()->tslices().begin())
       return nullptr;
-    return prev(_it_tslice)->slices().at(&_tubevector);
+    return prev(_it_tslice)->_slices[_tubevector.slot()].get();
   }
 
-  const std::shared_ptr<AbstractSlice> AbstractSlice::next_abstract_slice_ptr() const
+  const AbstractSlice* AbstractSlice::next_abstract_slice_ptr() const
   {
-    if(&(*_tubevector.last_abstract_slice_ptr()) == this)
+    if(next(_it_tslice) == _tubevector.tdomain()->tslices().end())
       return nullptr;
-    return next(_it_tslice)->slices().at(&_tubevector);
+    return next(_it_tslice)->_slices[_tubevector.slot()].get();
   }
 
 } // namespace codac
\ No newline at end of file
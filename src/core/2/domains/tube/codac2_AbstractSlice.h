@@ -33,15 +33,15 @@ namespace codac2
     public:
 
       AbstractSlice(const AbstractSlicedTube& tubevector, const std::list<TSlice>::iterator& _it_tslice);
-      virtual std::shared_ptr<AbstractSlice> duplicate() const = 0;
+      virtual SlicePtr duplicate() const = 0;
       virtual size_t size() const = 0;
       virtual void set_unbounded() = 0;
 
       const Interval& t0_tf() const;
       const TSlice& tslice() const;
 
-      const std::shared_ptr<AbstractSlice> prev_abstract_slice_ptr() const;
-      const std::shared_ptr<AbstractSlice> next_abstract_slice_ptr() const;
+      const AbstractSlice* prev_abstract_slice_ptr() const;
+      const AbstractSlice* next_abstract_slice_ptr() const;
 
 
     protected:
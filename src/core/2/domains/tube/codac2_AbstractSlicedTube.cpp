@@ -16,11 +16,16 @@ using namespace std;
 namespace codac2
 {
   AbstractSlicedTube::AbstractSlicedTube(const shared_ptr<TDomain>& tdomain) :
-    _tdomain(tdomain)
+    _tdomain(tdomain), _slot(tdomain->register_tube())
   {
 
   }
 
+  AbstractSlicedTube::~AbstractSlicedTube()
+  {
+    _tdomain->unregister_tube(_slot);
+  }
+
   shared_ptr<TDomain>& AbstractSlicedTube::tdomain()
   {
     return const_cast<shared_ptr<TDomain>&>(
@@ -36,4 +41,9 @@ namespace codac2
   {
     return _tdomain->t0_tf();
   }
+
+  size_t AbstractSlicedTube::slot() const
+  {
+    return _slot;
+  }
 } // namespace codac
\ No newline at end of file
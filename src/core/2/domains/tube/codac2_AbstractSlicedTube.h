@@ -23,18 +23,21 @@ namespace codac2
     public:
 
       AbstractSlicedTube(const std::shared_ptr<TDomain>& tdomain);
+      virtual ~AbstractSlicedTube();
 
-      virtual const std::shared_ptr<AbstractSlice>& first_abstract_slice_ptr() const = 0;
-      virtual const std::shared_ptr<AbstractSlice>& last_abstract_slice_ptr() const = 0;
+      virtual const AbstractSlice* first_abstract_slice_ptr() const = 0;
+      virtual const AbstractSlice* last_abstract_slice_ptr() const = 0;
 
       std::shared_ptr<TDomain>& tdomain();
       const std::shared_ptr<TDomain>& tdomain() const;
       Interval t0_tf() const;
+      size_t slot() const; // index of the slices of this tube in the tslices
 
 
     protected:
 
       std::shared_ptr<TDomain> _tdomain;
+      const size_t _slot;
   };
 } // namespace codac
 
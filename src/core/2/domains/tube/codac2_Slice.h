@@ -80,9 +80,9 @@ namespace codac2
         return _tubevector;
       }
 
-      virtual std::shared_ptr<AbstractSlice> duplicate() const
+      virtual SlicePtr duplicate() const
       {
-        return std::make_shared<Slice>(*this);
+        return _tubevector.tdomain()->template make_slice<Slice>(*this);
       }
 
       virtual size_t size() const
@@ -191,25 +191,25 @@ namespace codac2
         }
       }
 
-      const std::shared_ptr<Slice<T>> prev_slice_ptr() const
+      const Slice<T>* prev_slice_ptr() const
       {
-        return std::static_pointer_cast<Slice<T>>(prev_abstract_slice_ptr());
+        return static_cast<const Slice<T>*>(prev_abstract_slice_ptr());
       }
 
-      std::shared_ptr<Slice<T>> prev_slice_ptr()
+      Slice<T>* prev_slice_ptr()
       {
-        return std::const_pointer_cast<Slice<T>>(
+        return const_cast<Slice<T>*>(
           static_cast<const Slice&>(*this).prev_slice_ptr());
       }
 
-      const std::shared_ptr<Slice<T>> next_slice_ptr() const
+      const Slice<T>* next_slice_ptr() const
       {
-        return std::static_pointer_cast<Slice<T>>(next_abstract_slice_ptr());
+        return static_cast<const Slice<T>*>(next_abstract_slice_ptr());
       }
 
-      std::shared_ptr<Slice<T>> next_slice_ptr()
+      Slice<T>* next_slice_ptr()
       {
-        return std::const_pointer_cast<Slice<T>>(
+        return const_cast<Slice<T>*>(
           static_cast<const Slice&>(*this).next_slice_ptr());
       }
 
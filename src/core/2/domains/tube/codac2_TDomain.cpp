@@ -23,7 +23,7 @@ namespace codac2
   TDomain::TDomain(const Interval& t0_tf)
     : _tslices({ TSlice(t0_tf) })
   {
-
+    build_index();
   }
 
   TDomain::TDomain(const Interval& t0_tf, double dt, bool with_gates)
@@ -44,6 +44,8 @@ namespace codac2
 
     if(with_gates)
       _tslices.push_back(TSlice(Interval(t0_tf.ub())));
+
+    build_index();
   }
 
   const Interval TDomain::t0_tf() const
@@ -59,7 +61,49 @@ namespace codac2
 
   size_t TDomain::nb_tubes() const
   {
-    return _tslices.front().slices().size();
+    return _nb_tubes;
+  }
+
+  size_t TDomain::register_tube()
+  {
+    size_t slot;
+
+    if(!_free_slots.empty())
+    {
+      slot = _free_slots.back();
+      _free_slots.pop_back();
+    }
+
+    else
+    {
+      slot = _nb_slots++;
+      for(auto& ts : _tslices)
+        ts._slices.resize(_nb_slots);
+    }
+
+    _nb_tubes++;
+    return slot;
+  }
+
+  void TDomain::unregister_tube(size_t slot)
+  {
+    assert(slot < _nb_slots && _nb_tubes > 0);
+    _free_slots.push_back(slot);
+    _nb_tubes--;
+  }
+
+  void TDomain::index_tslice(const list<TSlice>::iterator& it)
+  {
+    auto [k, added] = _index.emplace(it->t0_tf().lb(), it);
+    if(!added && std::next(it) == k->second) // new first tslice for this lower bound
+      k->second = it;
+  }
+
+  void TDomain::build_index()
+  {
+    _index.clear();
+    for(auto it = _tslices.begin() ; it != _tslices.end() ; ++it)
+      index_tslice(it);
   }
 
   bool TDomain::all_gates_defined() const
@@ -97,16 +141,10 @@ namespace codac2
     if(!t0_tf().contains(t))
       return _tslices.end();
 
-    list<TSlice>::iterator it;
-    for(it = _tslices.begin(); it != _tslices.end(); ++it)
-    {
-      const Interval& tdom = it->t0_tf();
-      if((tdom.is_degenerated() && tdom.lb() == t) // gate
-        || (tdom.lb() <= t && tdom.ub() > t)) // slice
-        return it;
-    }
-
-    it = _tslices.end(); it--;
+    // Last tslices starting before t
+    list<TSlice>::iterator it = std::prev(_index.upper_bound(t))->second;
+    if(it->is_gate() && it->t0_tf().lb() < t)
+      ++it; // the slice following the gate contains t
     return it;
   }
   
@@ -123,12 +161,14 @@ namespace codac2
         return it;
 
       TSlice ts(*it, Interval(t, t0_tf().lb())); // duplicate with different tdomain
-      it = _tslices.insert(it, ts);
-      for(auto& [k,s] : it->_slices)
-      {
-        s->_it_tslice = it;
-        s->set_unbounded(); // reinitialization
-      }
+      it = _tslices.insert(it, std::move(ts));
+      index_tslice(it);
+      for(auto& s : it->_slices)
+        if(s)
+        {
+          s->_it_tslice = it;
+          s->set_unbounded(); // reinitialization
+        }
 
       if(with_gates)
       {
@@ -145,12 +185,14 @@ namespace codac2
     {
       it = _tslices.end();
       TSlice ts(*std::prev(it), Interval(t0_tf().ub(),t)); // duplicate with different tdomain
-      it = _tslices.insert(it, ts);
-      for(auto& [k,s] : it->_slices)
-      {
-        s->_it_tslice = it;
-        s->set_unbounded(); // reinitialization
-      }
+      it = _tslices.insert(it, std::move(ts));
+      index_tslice(it);
+      for(auto& s : it->_slices)
+        if(s)
+        {
+          s->_it_tslice = it;
+          s->set_unbounded(); // reinitialization
+        }
 
       if(with_gates)
         return sample(t, true); // recursive
@@ -178,9 +220,11 @@ namespace codac2
 
       // From C++ insert() doc: the container is extended by inserting new elements before the element at the specified position
       ++it; // we will insert the new tslice before the next TSlice [t.ub(),..]
-      it = _tslices.insert(it, ts); // then, it points to the newly inserted element
-      for(auto& [k,s] : it->_slices) // adding the new iterator pointer to the new slices
-        s->_it_tslice = it;
+      it = _tslices.insert(it, std::move(ts)); // then, it points to the newly inserted element
+      index_tslice(it);
+      for(auto& s : it->_slices) // adding the new iterator pointer to the new slices
+        if(s)
+          s->_it_tslice = it;
       
       // In case the sampling includes the creation of a gate, the method is called again at same t
       if(new_gate_added)
@@ -217,7 +261,15 @@ namespace codac2
     while(it != _tslices.end())
     {
       if(it->t0_tf().is_degenerated())
+      {
+        auto k = _index.find(it->t0_tf().lb());
+        assert(k != _index.end() && k->second == it);
+        if(std::next(it) != _tslices.end() && std::next(it)->t0_tf().lb() == k->first)
+          k->second = std::next(it); // the slice following the gate
+        else
+          _index.erase(k);
         _tslices.erase(it++);
+      }
 
       else
         ++it;
@@ -12,10 +12,12 @@
 #ifndef __CODAC2_TDOMAIN_H__
 #define __CODAC2_TDOMAIN_H__
 
+#include <new>
 #include <map>
 #include <list>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 #include "codac_Interval.h"
 #include "codac_predef_values.h"
@@ -25,6 +27,44 @@ namespace codac2
   using codac::Interval;
   class TSlice;
 
+  class AbstractSlice;
+
+  // Destroys a slice and gives its memory back to the pool of its TDomain,
+  // which outlives the slices of its tubes
+  class SliceDeleter
+  {
+    public:
+
+      SliceDeleter() = default;
+
+      template<typename S>
+      static SliceDeleter of(std::pmr::memory_resource& memory)
+      {
+        SliceDeleter d;
+        d._memory = &memory;
+        d._release = [](std::pmr::memory_resource& m, AbstractSlice* p)
+          {
+            S* s = static_cast<S*>(p);
+            s->~S();
+            m.deallocate(s, sizeof(S), alignof(S));
+          };
+        return d;
+      }
+
+      void operator()(AbstractSlice* p) const
+      {
+        _release(*_memory, p);
+      }
+
+    protected:
+
+      std::pmr::memory_resource* _memory = nullptr;
+      void (*_release)(std::pmr::memory_resource&, AbstractSlice*) = nullptr;
+  };
+
+  // Owner of a slice allocated from the pool of a TDomain (no reference counting)
+  using SlicePtr = std::unique_ptr<AbstractSlice,SliceDeleter>;
+
   class TDomain
   {
     public:
@@ -32,11 +72,11 @@ namespace codac2
       explicit TDomain(const Interval& t0_tf);
       explicit TDomain(const Interval& t0_tf, double dt, bool with_gates = false);
       const Interval t0_tf() const; // todo: keep this method?
-      std::list<TSlice>::iterator iterator_tslice(double t); // returns it on last slice if t==t_f, not end
+      std::list<TSlice>::iterator iterator_tslice(double t); // returns it on last slice if t==t_f, not end; O(log n)
       size_t nb_tslices() const;
       size_t nb_tubes() const;
       bool all_gates_defined() const;
-      std::list<TSlice>::iterator sample(double t, bool with_gate = false);
+      std::list<TSlice>::iterator sample(double t, bool with_gate = false); // O(log n), iterators stay valid
       void sample(const Interval& t0_tf, double dt, bool with_gates = false);
       friend std::ostream& operator<<(std::ostream& os, const TDomain& x);
       const std::list<TSlice>& tslices() const;
@@ -44,11 +84,43 @@ namespace codac2
       void delete_gates();
       static bool are_same(const std::shared_ptr<TDomain>& tdom1, const std::shared_ptr<TDomain>& tdom2);
 
+      template<typename S, typename... Args>
+      SlicePtr make_slice(Args&&... args)
+      {
+        // Slices created one after the other are contiguous in the pool of the TDomain
+        void* p = _memory.allocate(sizeof(S), alignof(S));
+        try
+        {
+          return SlicePtr(new(p) S(std::forward<Args>(args)...), SliceDeleter::of<S>(_memory));
+        }
+        catch(...)
+        {
+          _memory.deallocate(p, sizeof(S), alignof(S));
+          throw;
+        }
+      }
+
 
     protected:
+
+      size_t register_tube(); // returns the slot of the tube in the tslices
+      void unregister_tube(size_t slot);
+      void index_tslice(const std::list<TSlice>::iterator& it);
+      void build_index();
+
+      // Pool of the slices, grouped by size in chunks of growing size (not thread safe,
+      // as the sampling of the TDomain). Declared first: released after the tslices
+      std::pmr::unsynchronized_pool_resource _memory;
       
       std::list<TSlice> _tslices;
+      // Ordered index of the tslices: for each lower bound, the first tslice starting
+      // from it (a gate if any, and then the slice that follows it)
+      std::map<double,std::list<TSlice>::iterator> _index;
+      size_t _nb_slots = 0; // size of the slot vectors of the tslices
+      size_t _nb_tubes = 0;
+      std::vector<size_t> _free_slots; // slots released by destroyed tubes
 
+      friend class AbstractSlicedTube;
       template<typename U>
       friend class Tube;
   };
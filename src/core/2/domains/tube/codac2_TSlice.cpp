@@ -17,8 +17,7 @@ using namespace codac;
 
 namespace codac2
 {
-  TSlice::TSlice(const Interval& tdomain) :
-    _slices(map<const AbstractSlicedTube*,shared_ptr<AbstractSlice>>())
+  TSlice::TSlice(const Interval& tdomain)
   {
     set_tdomain(tdomain);
   }
@@ -26,9 +25,16 @@ namespace codac2
   TSlice::TSlice(const TSlice& tslice, const Interval& tdomain) :
     TSlice(tdomain)
   {
-    for(const auto&[k,s] : tslice._slices)
-      _slices.insert(pair<const AbstractSlicedTube*,shared_ptr<AbstractSlice>>(
-        k, s->duplicate()));
+    _slices.resize(tslice._slices.size());
+    for(size_t i = 0 ; i < _slices.size() ; i++)
+      if(tslice._slices[i])
+        _slices[i] = tslice._slices[i]->duplicate();
+  }
+
+  TSlice::TSlice(const TSlice& tslice) :
+    TSlice(tslice, tslice.t0_tf())
+  {
+
   }
 
   const Interval& TSlice::t0_tf() const
@@ -47,11 +53,17 @@ namespace codac2
     _t0_tf = tdomain;
   }
 
-  const map<const AbstractSlicedTube*,shared_ptr<AbstractSlice>>& TSlice::slices() const
+  const vector<SlicePtr>& TSlice::slices() const
   {
     return _slices;
   }
 
+  const AbstractSlice* TSlice::slice(const AbstractSlicedTube& tube) const
+  {
+    assert(tube.slot() < _slices.size() && _slices[tube.slot()]);
+    return _slices[tube.slot()].get();
+  }
+
   bool TSlice::operator==(const TSlice& x) const
   {
     return _t0_tf == x._t0_tf;
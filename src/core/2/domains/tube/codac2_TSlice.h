@@ -12,7 +12,6 @@
 #ifndef __CODAC2_TSLICE_H__
 #define __CODAC2_TSLICE_H__
 
-#include <map>
 #include <list>
 #include <vector>
 #include <memory>
@@ -34,9 +33,12 @@ namespace codac2
 
       explicit TSlice(const Interval& tdomain);
       TSlice(const TSlice& tslice, const Interval& tdomain); // performs a deep copy on slices
+      TSlice(const TSlice& tslice); // performs a deep copy on slices
+      TSlice(TSlice&& tslice) = default;
       const Interval& t0_tf() const;
       bool is_gate() const;
-      const std::map<const AbstractSlicedTube*,std::shared_ptr<AbstractSlice>>& slices() const;
+      const std::vector<SlicePtr>& slices() const; // indexed by the slots of the tubes
+      const AbstractSlice* slice(const AbstractSlicedTube& tube) const;
       bool operator==(const TSlice& x) const;
       bool operator!=(const TSlice& x) const;
       friend std::ostream& operator<<(std::ostream& os, const TSlice& x);
@@ -46,9 +48,10 @@ namespace codac2
       void set_tdomain(const Interval& tdomain);
       
       Interval _t0_tf;
-      std::map<const AbstractSlicedTube*,std::shared_ptr<AbstractSlice>> _slices;
+      std::vector<SlicePtr> _slices; // slices of the tubes, indexed by their slot
 
       friend class TDomain;
+      friend class AbstractSlice;
       template<typename U>
       friend class Tube;
   };
@@ -74,9 +74,7 @@ namespace codac2
         for(std::list<TSlice>::iterator it = _tdomain->_tslices.begin();
           it != _tdomain->_tslices.end(); ++it)
         {
-          it->_slices.insert(
-            std::pair<const AbstractSlicedTube*,std::shared_ptr<Slice<T>>>(this,
-              std::make_shared<Slice<T>>(default_value, *this, it)));
+          it->_slices[_slot] = _tdomain->make_slice<Slice<T>>(default_value, *this, it);
         }
       }
 
@@ -86,15 +84,14 @@ namespace codac2
         for(std::list<TSlice>::iterator it = _tdomain->_tslices.begin();
           it != _tdomain->_tslices.end(); ++it)
         {
-          std::shared_ptr<Slice<T>> s_ptr = std::make_shared<Slice<T>>(x(it), *this);
-          it->_slices.insert(std::pair<const AbstractSlicedTube*,std::shared_ptr<Slice<T>>>(this, s_ptr));
+          it->_slices[_slot] = _tdomain->make_slice<Slice<T>>(x(it), *this);
         }
       }
 
       ~Tube()
       {
         for(auto& s : _tdomain->_tslices)
-          s._slices.erase(this);
+          s._slices[_slot].reset();
       }
 
       Tube& operator=(const Tube& x)
@@ -136,24 +133,24 @@ namespace codac2
         return volume;
       }
 
-      virtual const std::shared_ptr<AbstractSlice>& first_abstract_slice_ptr() const
+      virtual const AbstractSlice* first_abstract_slice_ptr() const
       {
-        return _tdomain->tslices().front().slices().at(this);
+        return _tdomain->tslices().front().slice(*this);
       }
 
-      virtual const std::shared_ptr<AbstractSlice>& last_abstract_slice_ptr() const
+      virtual const AbstractSlice* last_abstract_slice_ptr() const
       {
-        return _tdomain->tslices().back().slices().at(this);
+        return _tdomain->tslices().back().slice(*this);
       }
 
-      const std::shared_ptr<Slice<T>> first_slice_ptr() const
+      const Slice<T>* first_slice_ptr() const
       {
-        return std::static_pointer_cast<Slice<T>>(first_abstract_slice_ptr());
+        return static_cast<const Slice<T>*>(first_abstract_slice_ptr());
       }
 
       const Slice<T>& first_slice() const
       {
-        return *first_slice_ptr();
+        return static_cast<const Slice<T>&>(*_tdomain->_tslices.front()._slices[_slot]);
       }
 
       Slice<T>& first_slice()
@@ -162,14 +159,14 @@ namespace codac2
           static_cast<const Tube&>(*this).first_slice());
       }
 
-      const std::shared_ptr<Slice<T>> last_slice_ptr() const
+      const Slice<T>* last_slice_ptr() const
       {
-        return std::static_pointer_cast<Slice<T>>(last_abstract_slice_ptr());
+        return static_cast<const Slice<T>*>(last_abstract_slice_ptr());
       }
 
       const Slice<T>& last_slice() const
       {
-        return *last_slice_ptr();
+        return static_cast<const Slice<T>&>(*_tdomain->_tslices.back()._slices[_slot]);
       }
 
       Slice<T>& last_slice()
@@ -225,9 +222,9 @@ namespace codac2
       }
       
       // Remove this? (direct access with () )
-      std::shared_ptr<Slice<T>> slice_ptr(const std::list<TSlice>::iterator& it)
+      Slice<T>* slice_ptr(const std::list<TSlice>::iterator& it)
       {
-        return std::static_pointer_cast<Slice<T>>(it->slices().at(this));
+        return static_cast<Slice<T>*>(it->_slices[_slot].get());
       }
       
       Slice<T>& operator()(const std::list<TSlice>::iterator& it)
@@ -238,7 +235,7 @@ namespace codac2
       
       const Slice<T>& operator()(const std::list<TSlice>::iterator& it) const
       {
-        return *std::static_pointer_cast<Slice<T>>(it->slices().at(this));
+        return static_cast<const Slice<T>&>(*it->_slices[_slot]);
       }
       
       TubeEvaluation<T> operator()(double t)
@@ -272,9 +269,9 @@ namespace codac2
         }
         std::list<TSlice>::iterator  it_t = _tdomain->iterator_tslice(t);
         assert(it_t != _tdomain->_tslices.end());
-        T x = std::static_pointer_cast<Slice<T>>(it_t->_slices.at(this))->codomain();
+        T x = (*this)(it_t).codomain();
         if(!it_t->is_gate() && t==it_t->t0_tf().lb() && it_t!=_tdomain->_tslices.begin())
-          x &= std::static_pointer_cast<Slice<T>>((--it_t)->_slices.at(this))->codomain();
+          x &= (*this)(--it_t).codomain();
         return x;
       }
       
@@ -292,12 +289,13 @@ namespace codac2
           return eval(t.lb());
 
         std::list<TSlice>::iterator it = _tdomain->iterator_tslice(t.lb());
-        T codomain = std::static_pointer_cast<Slice<T>>(it->_slices.at(this))->codomain();
+        const std::list<TSlice>::iterator it_end = std::next(_tdomain->iterator_tslice(t.ub()));
+        T codomain = (*this)(it).codomain();
 
-        while(it != std::next(_tdomain->iterator_tslice(t.ub())))
+        while(it != it_end)
         {
           if(it->t0_tf().lb() == t.ub()) break;
-          codomain |= std::static_pointer_cast<Slice<T>>(it->_slices.at(this))->codomain();
+          codomain |= (*this)(it).codomain();
           it++;
         }
 
@@ -353,8 +351,8 @@ namespace codac2
 
         while(it_this != _tdomain->tslices().end())
         {
-          if(*std::static_pointer_cast<Slice<T>>(it_this->_slices.at(this)) != 
-            *std::static_pointer_cast<Slice<T>>(it_x->slices().at(&x)))
+          if(static_cast<const Slice<T>&>(*it_this->_slices[_slot]) != 
+            static_cast<const Slice<T>&>(*it_x->_slices[x._slot]))
             return false;
           it_this++; it_x++;
         }
@@ -370,8 +368,8 @@ namespace codac2
 
         while(it_this != _tdomain->tslices().end())
         {
-          std::shared_ptr<Slice<T>> s = std::static_pointer_cast<Slice<T>>(it_this->_slices.at(this));
-          s->set(s->codomain() & std::static_pointer_cast<Slice<T>>(it_x->slices().at(&x))->codomain());
+          Slice<T>& s = (*this)(it_this);
+          s.set(s.codomain() & static_cast<const Slice<T>&>(*it_x->_slices[x._slot]).codomain());
           it_this++; it_x++;
         }
 
@@ -410,7 +408,7 @@ namespace codac2
 
           reference operator*()
           {
-            return static_cast<reference>(*((*this)->_slices.at(&_x)));
+            return static_cast<reference>(*(*this)->_slices[_x._slot]);
           }
 
         protected:
@@ -437,7 +435,7 @@ namespace codac2
 
           reference operator*()
           {
-            return static_cast<reference>(*((*this)->_slices.at(&_x)));
+            return static_cast<reference>(*(*this)->_slices[_x._slot]);
           }
 
         protected:
@@ -464,7 +462,7 @@ namespace codac2
 
           reference operator*() const
           {
-            return static_cast<reference>(*((*this)->_slices.at(&_x)));
+            return static_cast<reference>(*(*this)->_slices[_x._slot]);
           }
 
         protected:
@@ -70,7 +70,7 @@ class TubeComponent //: public AbstractConstTube<Interval,TubeComponent<T>>
     {
       assert(x.tdomain() == tdomain());
       for(auto& s : _tubevector)
-        s.set_component(_i, std::static_pointer_cast<Slice<T>>(s._it_tslice->_slices.at(&x._tubevector))->codomain()[x._i]);
+        s.set_component(_i, static_cast<const Slice<T>&>(*s.tslice().slice(x._tubevector)).codomain()[x._i]);
       return *this;
     }
 
@@ -78,7 +78,7 @@ class TubeComponent //: public AbstractConstTube<Interval,TubeComponent<T>>
     {
       assert(rel.second.tdomain() == tdomain());
       for(auto& s : _tubevector)
-        s.set_component(_i, rel.first(std::static_pointer_cast<Slice<T>>(s._it_tslice->_slices.at(&rel.second._tubevector))->codomain()[rel.second._i]));
+        s.set_component(_i, rel.first(static_cast<const Slice<T>&>(*s.tslice().slice(rel.second._tubevector)).codomain()[rel.second._i]));
       return *this;
     }
 
@@ -26,13 +26,13 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
+    TrajectorySamples map_y = x.samples();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
+    for(TrajectorySamples::iterator it = map_y.begin() ;
       it != map_y.end() ; it++)
       it->second = -it->second;
 
-    return Trajectory(map_y);
+    return Trajectory(std::move(map_y));
   }
     
   #define macro_scal_unary(f) \
@@ -42,13 +42,13 @@ namespace codac
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES \
         && "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
+      TrajectorySamples map_y = x.samples(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = std::f(it->second); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
     \
 
@@ -61,13 +61,13 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
+    TrajectorySamples map_y = x.samples();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
+    for(TrajectorySamples::iterator it = map_y.begin() ;
       it != map_y.end() ; it++)
       it->second = std::pow(it->second,2);
 
-    return Trajectory(map_y);
+    return Trajectory(std::move(map_y));
   }
 
   macro_scal_unary(sqrt);
@@ -91,13 +91,13 @@ namespace codac
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
+      TrajectorySamples map_y = x.samples(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = std::f(it->second, param); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
     \
   
@@ -109,12 +109,12 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
-    for(map<double,double>::iterator it = map_y.begin() ;
+    TrajectorySamples map_y = x.samples();
+    for(TrajectorySamples::iterator it = map_y.begin() ;
       it != map_y.end() ; it++)
       it->second = std::pow(it->second, 1. / p);
 
-    return Trajectory(map_y);
+    return Trajectory(std::move(map_y));
   }
 
   #define macro_scal_binary_arith(f) \
@@ -130,17 +130,18 @@ namespace codac
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> new_map; \
-      map<double,double>::const_iterator it_x1 = x1_sampled.sampled_map().begin(); \
-      map<double,double>::const_iterator it_x2 = x2_sampled.sampled_map().begin(); \
+      TrajectorySamples new_map; \
+      new_map.reserve(x1_sampled.samples().size()); \
+      TrajectorySamples::const_iterator it_x1 = x1_sampled.samples().begin(); \
+      TrajectorySamples::const_iterator it_x2 = x2_sampled.samples().begin(); \
       \
-      while(it_x1 != x1_sampled.sampled_map().end()) \
+      while(it_x1 != x1_sampled.samples().end()) \
       { \
-        new_map[it_x1->first] = it_x1->second f it_x2->second; \
+        new_map.push_back(it_x1->first, it_x1->second f it_x2->second); \
         it_x1++; it_x2++; \
       } \
       \
-      return Trajectory(new_map); \
+      return Trajectory(std::move(new_map)); \
     } \
     \
     const Trajectory operator f(const Trajectory& x1, double x2) \
@@ -149,13 +150,13 @@ namespace codac
         "not supported yet for trajectories defined by a Function"); \
       \
       Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
+      TrajectorySamples map_y = y.samples(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = it->second f x2; \
       \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
     \
     const Trajectory operator f(double x1, const Trajectory& x2) \
@@ -164,13 +165,13 @@ namespace codac
         "not supported yet for trajectories defined by a Function"); \
       \
       Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
+      TrajectorySamples map_y = y.samples(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = x1 f it->second; \
       \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
     \
 
@@ -192,10 +193,10 @@ namespace codac
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> map_x1 = x1.sampled_map(), map_x2 = x2.sampled_map(); \
+      TrajectorySamples map_x1 = x1.samples(), map_x2 = x2.samples(); \
     \
-      map<double,double>::iterator it_x1 = map_x1.begin(); \
-      map<double,double>::iterator it_x2 = map_x2.begin(); \
+      TrajectorySamples::iterator it_x1 = map_x1.begin(); \
+      TrajectorySamples::iterator it_x2 = map_x2.begin(); \
     \
       while(it_x1 != map_x1.end()) \
       { \
@@ -203,7 +204,7 @@ namespace codac
         it_x1++; it_x2++; \
       } \
     \
-      return Trajectory(map_x1); \
+      return Trajectory(std::move(map_x1)); \
     } \
     \
     const Trajectory f(const Trajectory& x1, double x2) \
@@ -212,13 +213,13 @@ namespace codac
         "not supported yet for trajectories defined by a Function"); \
     \
       Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
+      TrajectorySamples map_y = y.samples(); \
     \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = std::f(it->second, x2); \
     \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
     \
     const Trajectory f(double x1, const Trajectory& x2) \
@@ -227,13 +228,13 @@ namespace codac
         "not supported yet for trajectories defined by a Function"); \
     \
       Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
+      TrajectorySamples map_y = y.samples(); \
     \
-      for(map<double,double>::iterator it = map_y.begin() ; \
+      for(TrajectorySamples::iterator it = map_y.begin() ; \
         it != map_y.end() ; it++) \
         it->second = std::f(x1, it->second); \
     \
-      return Trajectory(map_y); \
+      return Trajectory(std::move(map_y)); \
     } \
 
   macro_scal_binary_f(atan2);
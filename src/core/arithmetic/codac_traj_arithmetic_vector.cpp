@@ -90,14 +90,15 @@ namespace codac
     assert(x1.nb_cols() == x2.size());
 
     TrajectoryVector x2_(x2);
-    // Same sampling for all components of this trajectory
-    for(int i = 0 ; i < x2_.size() ; i++)
-      for(int j = 0 ; j < x2_.size() ; j++)
-        if(i != j)
-          x2_[i].sample(x2_[j]);
-
-    TrajectoryVector result(x2.size());
-    for(auto const& it : x2_[0].sampled_map())
+    // Same sampling for all components of this trajectory:
+    // the keys are merged in the first component, then shared
+    for(int i = 1 ; i < x2_.size() ; i++)
+      x2_[0].sample(x2_[i]);
+    for(int i = 1 ; i < x2_.size() ; i++)
+      x2_[i].sample(x2_[0]);
+
+    TrajectoryVector result(x1.nb_rows());
+    for(auto const& it : x2_[0].samples())
       result.set(x1*x2_(it.first), it.first);
     
     return result;
@@ -143,7 +144,7 @@ namespace codac
     assert(x1.size() == 3 && x2.size() == 3);
 
     TrajectoryVector result(x1.size());
-    for(auto const& it : x1[0].sampled_map())
+    for(auto const& it : x1[0].samples())
       result.set(vecto_product(x1(it.first),x2), it.first);
 
     return result;
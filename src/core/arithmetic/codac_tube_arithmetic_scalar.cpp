@@ -11,6 +11,7 @@
 
 #include "codac_tube_arithmetic.h"
 #include "codac_Slice.h"
+#include "codac_tube_kernels.h"
 
 using namespace std;
 using namespace ibex;
@@ -25,29 +26,7 @@ namespace codac
   const Tube operator-(const Tube& x)
   {
     Tube y(x);
-    Slice *s_y = nullptr;
-    const Slice *s_x = nullptr;
-
-    do
-    {
-      if(s_y == nullptr) // first iteration
-      {
-        s_y = y.first_slice();
-        s_x = x.first_slice();
-      }
-
-      else
-      {
-        s_y = s_y->next_slice();
-        s_x = s_x->next_slice();
-      }
-
-      s_y->set_envelope(-s_x->codomain(), false);
-      s_y->set_input_gate(-s_x->input_gate(), false);
-
-    } while(s_y->next_slice());
-
-    s_y->set_output_gate(-s_x->output_gate(), false);
+    TubeKernels::map(y, [](const Interval& v) { return -v; });
     return y;
   }
     
@@ -56,29 +35,7 @@ namespace codac
     const Tube f(const Tube& x) \
     { \
       Tube y(x); \
-      Slice *s_y = nullptr; \
-      const Slice *s_x = nullptr; \
-      \
-      do \
-      { \
-        if(s_y == nullptr) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x = x.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x = s_x->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x->codomain()), false); \
-        s_y->set_input_gate(ibex::f(s_x->input_gate()), false); \
-        \
-      } while(s_y->next_slice()); \
-      \
-      s_y->set_output_gate(ibex::f(s_x->output_gate()), false); \
+      TubeKernels::map(y, [](const Interval& v) { return ibex::f(v); }); \
       return y; \
     } \
     \
@@ -106,29 +63,7 @@ namespace codac
     const Tube f(const Tube& x, p param) \
     { \
       Tube y(x); \
-      Slice *s_y = nullptr; \
-      const Slice *s_x = nullptr; \
-      \
-      do \
-      { \
-        if(s_y == nullptr) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x = x.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x = s_x->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x->codomain(), param), false); \
-        s_y->set_input_gate(ibex::f(s_x->input_gate(), param), false); \
-        \
-      } while(s_y->next_slice()); \
-      \
-      s_y->set_output_gate(ibex::f(s_x->output_gate(), param), false); \
+      TubeKernels::map(y, [&param](const Interval& v) { return ibex::f(v, param); }); \
       return y; \
     } \
     \
@@ -145,110 +80,35 @@ namespace codac
       assert(x1.tdomain() == x2.tdomain()); \
       \
       Tube y(x1); \
-      const Slice *s_x1, *s_x2; \
-      \
-      Tube *x1_resampled = nullptr; /* In case of different slicing between x1 and x2, */ \
-      Tube *x2_resampled = nullptr; /* copies of x1 and x2 will be made and equally resampled. */ \
+      auto kernel = [](const Interval& v1, const Interval& v2) { return ibex::f(v1, v2); }; \
       \
       if(Tube::same_slicing(x1, x2)) /* faster, no sampling computation needed */ \
-      { \
-        s_x1 = x1.first_slice(); \
-        s_x2 = x2.first_slice(); \
-      } \
+        TubeKernels::map(y, x2, kernel); \
       \
       else \
       { \
-        x1_resampled = new Tube(x1); \
-        x2_resampled = new Tube(x2); \
-        x1_resampled->sample(x2); /* common sampling */ \
-        x2_resampled->sample(x1); \
-        y.sample(*x2_resampled); \
-        s_x1 = x1_resampled->first_slice(); \
-        s_x2 = x2_resampled->first_slice(); \
+        /* In case of different slicing between x1 and x2, */ \
+        /* y and a copy of x2 are equally resampled. */ \
+        Tube x2_resampled(x2); \
+        x2_resampled.sample(x1); /* common sampling */ \
+        y.sample(x2); \
+        TubeKernels::map(y, x2_resampled, kernel); \
       } \
       \
-      Slice *s_y = nullptr; \
-      do \
-      { \
-        if(s_y == nullptr) /* first iteration */ \
-          s_y = y.first_slice(); \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x1 = s_x1->next_slice(); \
-          s_x2 = s_x2->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x1->codomain(), s_x2->codomain()), false); \
-        s_y->set_input_gate(ibex::f(s_x1->input_gate(), s_x2->input_gate()), false); \
-        \
-      } while(s_y->next_slice()); \
-      \
-      s_y->set_output_gate(ibex::f(s_x1->output_gate(), s_x2->output_gate()), false); \
-      \
-      if(x1_resampled) delete x1_resampled; \
-      if(x2_resampled) delete x2_resampled; \
       return y; \
     } \
     \
     const Tube f(const Tube& x1, const Interval& x2) \
     { \
       Tube y(x1); \
-      Slice *s_y = nullptr; \
-      const Slice *s_x1 = nullptr; \
-      \
-      do \
-      { \
-        if(s_y == nullptr) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x1 = x1.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x1 = s_x1->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x1->codomain(), x2), false); \
-        s_y->set_input_gate(ibex::f(s_x1->input_gate(), x2), false); \
-        \
-      } while(s_y->next_slice()); \
-      \
-      s_y->set_output_gate(ibex::f(s_x1->output_gate(), x2), false); \
-      \
+      TubeKernels::map(y, [&x2](const Interval& v1) { return ibex::f(v1, x2); }); \
       return y; \
     } \
     \
     const Tube f(const Interval& x1, const Tube& x2) \
     { \
       Tube y(x2); \
-      Slice *s_y = nullptr; \
-      const Slice *s_x2 = nullptr; \
-      \
-      do \
-      { \
-        if(s_y == nullptr) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x2 = x2.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x2 = s_x2->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(x1, s_x2->codomain()), false); \
-        s_y->set_input_gate(ibex::f(x1, s_x2->input_gate()), false); \
-        \
-      } while(s_y->next_slice()); \
-      \
-      s_y->set_output_gate(ibex::f(x1, s_x2->output_gate()), false); \
-      \
+      TubeKernels::map(y, [&x1](const Interval& v2) { return ibex::f(x1, v2); }); \
       return y; \
     } \
 
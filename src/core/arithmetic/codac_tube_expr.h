@@ -0,0 +1,605 @@
+/**
+ *  \file
+ *  Lazy expressions on tubes and trajectories
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBE_EXPR_H__
+#define __CODAC_TUBE_EXPR_H__
+
+#include <map>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "codac_Interval.h"
+#include "codac_IntervalVector.h"
+#include "codac_Vector.h"
+#include "codac_Slice.h"
+#include "codac_Tube.h"
+#include "codac_TubeVector.h"
+#include "codac_Trajectory.h"
+#include "codac_TrajectoryVector.h"
+#include "codac_Exception.h"
+
+namespace codac
+{
+  /**
+   * \enum ExprPart
+   * \brief Part of a slice on which an expression is evaluated
+   */
+  enum class ExprPart { INPUT_GATE, ENVELOPE, OUTPUT_GATE };
+
+  /**
+   * \struct ExprPoint
+   * \brief Location of the evaluation of an expression on the slices of its result
+   */
+  struct ExprPoint
+  {
+    int i; //!< component of the vector operands
+    int k; //!< index of the slice of the result
+    const Slice *s; //!< slice of the result
+    ExprPart part; //!< evaluated part of the slice
+  };
+
+  /**
+   * \struct ExprOperands
+   * \brief Dynamical operands of an expression, collected before its evaluation
+   */
+  struct ExprOperands
+  {
+    std::vector<const Tube*> v_tubes; //!< scalar tubes, and components of vector tubes
+    std::vector<const Trajectory*> v_trajs; //!< scalar trajectories
+    std::vector<const TrajectoryVector*> v_traj_vectors; //!< vector trajectories
+    int size = 0; //!< dimension of the vector operands, 0 if the expression is scalar
+
+    /**
+     * \brief Registers the dimension of a vector operand
+     *
+     * \param n dimension of the operand
+     */
+    void add_size(int n)
+    {
+      if(size != 0 && size != n)
+        throw Exception(__func__, "vector operands of different dimensions");
+      size = n;
+    }
+  };
+
+  class ExprBase { }; //!< tag of the expression types
+
+  /**
+   * \class TubeExpr
+   * \brief Lazy arithmetic expression on tubes, trajectories and constant values.
+   *
+   * An expression is built with lazy() on its operands, for instance:
+   * \code
+   * Tube y = lazy(x) + 2.*cos(lazy(v)) - lazy(z)*lazy(z);
+   * \endcode
+   * The nodes of the expression only refer to their operands. No intermediate
+   * tube is created: the result is computed in one pass over its slices
+   * when the expression is converted into a Tube or TubeVector
+   * (or a Trajectory or TrajectoryVector when no tube is involved).
+   *
+   * The slicing of the result is the union of the slicings of the tubes of the
+   * expression, and the values are the same as with the arithmetic on tubes.
+   *
+   * \note The operands must not be destroyed before the evaluation of the expression.
+   */
+  template<typename E>
+  class TubeExpr : public ExprBase
+  {
+    public:
+
+      /**
+       * \brief Returns the actual expression
+       *
+       * \return a const reference to the derived object
+       */
+      const E& expr() const
+      {
+        return static_cast<const E&>(*this);
+      }
+
+      /**
+       * \brief Evaluates this scalar expression into a tube
+       *
+       * \return the resulting tube
+       */
+      operator Tube() const
+      {
+        ExprOperands op;
+        expr().collect(op);
+        if(op.size != 0)
+          throw Exception(__func__, "vector expression evaluated as a Tube");
+
+        Tube y = slicing(op);
+        expr().prepare(y);
+        eval_tube(y, 0);
+        return y;
+      }
+
+      /**
+       * \brief Evaluates this vector expression into a vector of tubes
+       *
+       * \return the resulting tube
+       */
+      operator TubeVector() const
+      {
+        ExprOperands op;
+        expr().collect(op);
+        if(op.size == 0)
+          throw Exception(__func__, "scalar expression evaluated as a TubeVector");
+
+        const Tube y_slicing = slicing(op);
+        expr().prepare(y_slicing);
+        TubeVector y(op.size, y_slicing);
+        for(int i = 0 ; i < op.size ; i++)
+          eval_tube(y[i], i);
+        return y;
+      }
+
+      /**
+       * \brief Evaluates this scalar expression into a trajectory
+       *
+       * \return the resulting trajectory
+       */
+      operator Trajectory() const
+      {
+        ExprOperands op;
+        expr().collect(op);
+        if(op.size != 0)
+          throw Exception(__func__, "vector expression evaluated as a Trajectory");
+
+        return Trajectory(eval_traj(op, 0));
+      }
+
+      /**
+       * \brief Evaluates this vector expression into a vector of trajectories
+       *
+       * \return the resulting trajectory
+       */
+      operator TrajectoryVector() const
+      {
+        ExprOperands op;
+        expr().collect(op);
+        if(op.size == 0)
+          throw Exception(__func__, "scalar expression evaluated as a TrajectoryVector");
+
+        std::vector<std::map<double,double>> v_maps;
+        for(int i = 0 ; i < op.size ; i++)
+          v_maps.push_back(eval_traj(op, i));
+        return TrajectoryVector(v_maps);
+      }
+
+    protected:
+
+      /**
+       * \brief Computes the slicing of the result, union of the slicings of the tubes
+       *
+       * \param op operands of the expression
+       * \return a tube with the slicing of the result
+       */
+      static Tube slicing(const ExprOperands& op)
+      {
+        if(op.v_tubes.empty())
+          throw Exception(__func__, "no tube in the expression, the slicing cannot be defined");
+
+        Tube y(*op.v_tubes[0]);
+        for(size_t j = 1 ; j < op.v_tubes.size() ; j++)
+        {
+          assert(y.tdomain() == op.v_tubes[j]->tdomain());
+          if(!Tube::same_slicing(y, *op.v_tubes[j]))
+            y.sample(*op.v_tubes[j]);
+        }
+
+        return y;
+      }
+
+      /**
+       * \brief Evaluates a component of this expression on the slices of a tube
+       *
+       * \param y the resulting tube, already sliced
+       * \param i the component of the vector operands
+       */
+      void eval_tube(Tube& y, int i) const
+      {
+        ExprPoint p = { i, 0, nullptr, ExprPart::INPUT_GATE };
+
+        for(Slice *s = y.first_slice() ; s ; s = s->next_slice())
+        {
+          p.s = s;
+
+          if(p.k == 0)
+          {
+            p.part = ExprPart::INPUT_GATE;
+            s->set_input_gate(expr().eval(p), false);
+          }
+
+          p.part = ExprPart::ENVELOPE;
+          s->set_envelope(expr().eval(p), false);
+          p.part = ExprPart::OUTPUT_GATE;
+          s->set_output_gate(expr().eval(p), false);
+          p.k++;
+        }
+      }
+
+      /**
+       * \brief Evaluates a component of this expression at the sampling
+       *        times of the trajectories
+       *
+       * \note The result is defined on the intersection of the tdomains of the trajectories,
+       *       the sampling times outside of it are not considered
+       *
+       * \param op operands of the expression
+       * \param i the component of the vector operands
+       * \return the map of values of the resulting trajectory
+       */
+      std::map<double,double> eval_traj(const ExprOperands& op, int i) const
+      {
+        if(!op.v_tubes.empty())
+          throw Exception(__func__, "tubes cannot be evaluated as trajectories");
+
+        // Common tdomain and union of the sampling times
+        Interval tdomain = Interval::ALL_REALS;
+        std::vector<double> v_t;
+        auto add_times = [&tdomain,&v_t](const Trajectory& x)
+        {
+          tdomain &= x.tdomain();
+          if(x.definition_type() == TrajDefnType::MAP_OF_VALUES)
+            for(const auto& it : x.samples())
+              v_t.push_back(it.first);
+        };
+
+        for(const auto& x : op.v_trajs)
+          add_times(*x);
+        for(const auto& x : op.v_traj_vectors)
+          add_times((*x)[i]);
+
+        if(v_t.empty())
+          throw Exception(__func__, "not supported yet for trajectories defined by a Function");
+
+        if(tdomain.is_empty())
+          throw Exception(__func__, "trajectories with disjoint tdomains");
+
+        // Each operand is evaluated on its tdomain only
+        v_t.erase(std::remove_if(v_t.begin(), v_t.end(),
+          [&tdomain](double t) { return !tdomain.contains(t); }), v_t.end());
+        v_t.push_back(tdomain.lb());
+        v_t.push_back(tdomain.ub());
+
+        std::sort(v_t.begin(), v_t.end());
+        v_t.erase(std::unique(v_t.begin(), v_t.end()), v_t.end());
+
+        std::map<double,double> map_y;
+        for(double t : v_t)
+          map_y.emplace_hint(map_y.end(), t, expr().eval(t, i));
+        return map_y;
+      }
+  };
+
+  /**
+   * \class ExprConst
+   * \brief Constant operand of an expression (Interval, IntervalVector or real values)
+   */
+  class ExprConst : public TubeExpr<ExprConst>
+  {
+    public:
+
+      explicit ExprConst(const Interval& x) : m_x(1, x), m_scalar(true) { }
+      explicit ExprConst(const IntervalVector& x) : m_x(x), m_scalar(false) { }
+
+      void collect(ExprOperands& op) const { if(!m_scalar) op.add_size(m_x.size()); }
+      void prepare(const Tube&) const { }
+      Interval eval(const ExprPoint& p) const { return m_x[m_scalar ? 0 : p.i]; }
+
+      double eval(double, int i) const
+      {
+        const Interval& x = m_x[m_scalar ? 0 : i];
+        assert(x.is_degenerated() && "trajectories require real values");
+        return x.lb();
+      }
+
+    protected:
+
+      const IntervalVector m_x; //!< constant value
+      const bool m_scalar; //!< true if the value is an Interval, broadcast to the components
+  };
+
+  /**
+   * \class ExprTube
+   * \brief Tube operand of an expression (Tube or TubeVector)
+   */
+  class ExprTube : public TubeExpr<ExprTube>
+  {
+    public:
+
+      explicit ExprTube(const Tube& x) : m_x(&x) { }
+      explicit ExprTube(const TubeVector& x) : m_v(&x) { }
+
+      void collect(ExprOperands& op) const
+      {
+        if(m_x)
+          op.v_tubes.push_back(m_x);
+
+        else
+        {
+          op.add_size(m_v->size());
+          for(int i = 0 ; i < m_v->size() ; i++)
+            op.v_tubes.push_back(&(*m_v)[i]);
+        }
+      }
+
+      void prepare(const Tube& y) const
+      {
+        m_same_slicing.clear();
+        for(int i = 0 ; i < (m_x ? 1 : m_v->size()) ; i++)
+          m_same_slicing.push_back(Tube::same_slicing(y, tube(i)));
+      }
+
+      Interval eval(const ExprPoint& p) const
+      {
+        const Tube& x = tube(p.i);
+
+        if(m_same_slicing[m_x ? 0 : p.i]) // direct access to the corresponding slice
+        {
+          const Slice *s = x.slice(p.k);
+          switch(p.part)
+          {
+            case ExprPart::INPUT_GATE: return s->input_gate();
+            case ExprPart::OUTPUT_GATE: return s->output_gate();
+            default: return s->codomain();
+          }
+        }
+
+        else // the result is more finely sliced than the operand
+        {
+          switch(p.part)
+          {
+            case ExprPart::INPUT_GATE: return x(p.s->tdomain().lb());
+            case ExprPart::OUTPUT_GATE: return x(p.s->tdomain().ub());
+            default: return x.slice(x.time_to_index(p.s->tdomain().mid()))->codomain();
+          }
+        }
+      }
+
+      double eval(double, int) const
+      {
+        assert(false && "tubes cannot be evaluated as trajectories");
+        return 0.;
+      }
+
+    protected:
+
+      const Tube& tube(int i) const { return m_x ? *m_x : (*m_v)[i]; }
+
+      const Tube *m_x = nullptr; //!< scalar operand
+      const TubeVector *m_v = nullptr; //!< vector operand
+      mutable std::vector<bool> m_same_slicing; //!< for each component, true if sliced as the result
+  };
+
+  /**
+   * \class ExprTraj
+   * \brief Trajectory operand of an expression (Trajectory or TrajectoryVector)
+   */
+  class ExprTraj : public TubeExpr<ExprTraj>
+  {
+    public:
+
+      explicit ExprTraj(const Trajectory& x) : m_x(&x) { }
+      explicit ExprTraj(const TrajectoryVector& x) : m_v(&x) { }
+
+      void collect(ExprOperands& op) const
+      {
+        if(m_x)
+          op.v_trajs.push_back(m_x);
+
+        else
+        {
+          op.add_size(m_v->size());
+          op.v_traj_vectors.push_back(m_v);
+        }
+      }
+
+      void prepare(const Tube&) const { }
+
+      Interval eval(const ExprPoint& p) const
+      {
+        const Trajectory& x = traj(p.i);
+        switch(p.part)
+        {
+          case ExprPart::INPUT_GATE: return x(Interval(p.s->tdomain().lb()));
+          case ExprPart::OUTPUT_GATE: return x(Interval(p.s->tdomain().ub()));
+          default: return x(p.s->tdomain());
+        }
+      }
+
+      double eval(double t, int i) const { return traj(i)(t); }
+
+    protected:
+
+      const Trajectory& traj(int i) const { return m_x ? *m_x : (*m_v)[i]; }
+
+      const Trajectory *m_x = nullptr; //!< scalar operand
+      const TrajectoryVector *m_v = nullptr; //!< vector operand
+  };
+
+  /**
+   * \class ExprUnary
+   * \brief Unary operation of an expression
+   */
+  template<typename Op, typename E>
+  class ExprUnary : public TubeExpr<ExprUnary<Op,E>>
+  {
+    public:
+
+      explicit ExprUnary(const E& e) : m_e(e) { }
+
+      void collect(ExprOperands& op) const { m_e.collect(op); }
+      void prepare(const Tube& y) const { m_e.prepare(y); }
+      Interval eval(const ExprPoint& p) const { return Op::apply(m_e.eval(p)); }
+      double eval(double t, int i) const { return Op::apply(m_e.eval(t, i)); }
+
+    protected:
+
+      const E m_e; //!< operand
+  };
+
+  /**
+   * \class ExprBinary
+   * \brief Binary operation of an expression
+   */
+  template<typename Op, typename E1, typename E2>
+  class ExprBinary : public TubeExpr<ExprBinary<Op,E1,E2>>
+  {
+    public:
+
+      explicit ExprBinary(const E1& e1, const E2& e2) : m_e1(e1), m_e2(e2) { }
+
+      void collect(ExprOperands& op) const { m_e1.collect(op); m_e2.collect(op); }
+      void prepare(const Tube& y) const { m_e1.prepare(y); m_e2.prepare(y); }
+      Interval eval(const ExprPoint& p) const { return Op::apply(m_e1.eval(p), m_e2.eval(p)); }
+      double eval(double t, int i) const { return Op::apply(m_e1.eval(t, i), m_e2.eval(t, i)); }
+
+    protected:
+
+      const E1 m_e1; //!< first operand
+      const E2 m_e2; //!< second operand
+  };
+
+  /// \name Definition of expressions
+  /// @{
+
+    /** \brief Lazy operand \f$[x](\cdot)\f$, see TubeExpr
+      * \param x
+      * \return expression
+      */
+    inline ExprTube lazy(const Tube& x) { return ExprTube(x); }
+
+    /** \brief Lazy operand \f$[\mathbf{x}](\cdot)\f$, see TubeExpr
+      * \param x
+      * \return expression
+      */
+    inline ExprTube lazy(const TubeVector& x) { return ExprTube(x); }
+
+    /** \brief Lazy operand \f$x(\cdot)\f$, see TubeExpr
+      * \param x
+      * \return expression
+      */
+    inline ExprTraj lazy(const Trajectory& x) { return ExprTraj(x); }
+
+    /** \brief Lazy operand \f$\mathbf{x}(\cdot)\f$, see TubeExpr
+      * \param x
+      * \return expression
+      */
+    inline ExprTraj lazy(const TrajectoryVector& x) { return ExprTraj(x); }
+
+  /// @}
+
+  /**
+   * \struct ExprOperand
+   * \brief Conversion of the operands of the expression operators into expressions
+   */
+  template<typename T, typename Enable = void>
+  struct ExprOperand { };
+
+  template<typename E>
+  struct ExprOperand<E, typename std::enable_if<std::is_base_of<ExprBase,E>::value>::type>
+  {
+    typedef E type;
+    static const E& make(const E& e) { return e; }
+  };
+
+  template<typename T>
+  struct ExprOperand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  {
+    typedef ExprConst type;
+    static ExprConst make(T x) { return ExprConst(Interval(x)); }
+  };
+
+  #define macro_expr_operand(T, E) \
+    \
+    template<> \
+    struct ExprOperand<T> \
+    { \
+      typedef E type; \
+      static E make(const T& x) { return E(x); } \
+    }; \
+
+  macro_expr_operand(Interval, ExprConst);
+  macro_expr_operand(IntervalVector, ExprConst);
+  macro_expr_operand(Vector, ExprConst);
+  macro_expr_operand(Tube, ExprTube);
+  macro_expr_operand(TubeVector, ExprTube);
+  macro_expr_operand(Trajectory, ExprTraj);
+  macro_expr_operand(TrajectoryVector, ExprTraj);
+
+  // Operators are only defined when one of the operands is an expression,
+  // the other operands are converted by ExprOperand
+  template<typename T1, typename T2>
+  using ExprEnableBinary = typename std::enable_if<
+    std::is_base_of<ExprBase,T1>::value || std::is_base_of<ExprBase,T2>::value>::type;
+
+  #define macro_expr_unary(name, f, interval_f, real_f) \
+    \
+    struct Expr_##name \
+    { \
+      static Interval apply(const Interval& x) { return interval_f; } \
+      static double apply(double x) { return real_f; } \
+    }; \
+    \
+    template<typename E> \
+    inline ExprUnary<Expr_##name,E> f(const TubeExpr<E>& e) \
+    { \
+      return ExprUnary<Expr_##name,E>(e.expr()); \
+    } \
+
+  #define macro_expr_binary(name, f, interval_f, real_f) \
+    \
+    struct Expr_##name \
+    { \
+      static Interval apply(const Interval& x1, const Interval& x2) { return interval_f; } \
+      static double apply(double x1, double x2) { return real_f; } \
+    }; \
+    \
+    template<typename T1, typename T2, typename = ExprEnableBinary<T1,T2>> \
+    inline ExprBinary<Expr_##name,typename ExprOperand<T1>::type,typename ExprOperand<T2>::type> \
+      f(const T1& x1, const T2& x2) \
+    { \
+      return ExprBinary<Expr_##name,typename ExprOperand<T1>::type,typename ExprOperand<T2>::type>( \
+        ExprOperand<T1>::make(x1), ExprOperand<T2>::make(x2)); \
+    } \
+
+  /// \name Operations on expressions
+  /// @{
+
+    macro_expr_unary(neg, operator-, -x, -x);
+    macro_expr_unary(cos, cos, ibex::cos(x), std::cos(x));
+    macro_expr_unary(sin, sin, ibex::sin(x), std::sin(x));
+    macro_expr_unary(tan, tan, ibex::tan(x), std::tan(x));
+    macro_expr_unary(abs, abs, ibex::abs(x), std::fabs(x));
+    macro_expr_unary(sqr, sqr, ibex::sqr(x), x*x);
+    macro_expr_unary(sqrt, sqrt, ibex::sqrt(x), std::sqrt(x));
+    macro_expr_unary(exp, exp, ibex::exp(x), std::exp(x));
+    macro_expr_unary(log, log, ibex::log(x), std::log(x));
+    macro_expr_unary(acos, acos, ibex::acos(x), std::acos(x));
+    macro_expr_unary(asin, asin, ibex::asin(x), std::asin(x));
+    macro_expr_unary(atan, atan, ibex::atan(x), std::atan(x));
+    macro_expr_unary(cosh, cosh, ibex::cosh(x), std::cosh(x));
+    macro_expr_unary(sinh, sinh, ibex::sinh(x), std::sinh(x));
+    macro_expr_unary(tanh, tanh, ibex::tanh(x), std::tanh(x));
+
+    macro_expr_binary(add, operator+, x1 + x2, x1 + x2);
+    macro_expr_binary(sub, operator-, x1 - x2, x1 - x2);
+    macro_expr_binary(mul, operator*, x1 * x2, x1 * x2);
+    macro_expr_binary(div, operator/, x1 / x2, x1 / x2);
+
+  /// @}
+}
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ *  \file
+ *  TubeKernels class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBE_KERNELS_H__
+#define __CODAC_TUBE_KERNELS_H__
+
+#include <cassert>
+#include "codac_Interval.h"
+#include "codac_Slice.h"
+#include "codac_Tube.h"
+
+namespace codac
+{
+  /**
+   * \class TubeKernels
+   * \brief Batch evaluation of interval functions over all the values of a tube.
+   *
+   * The values (envelopes and gates) are updated in place, in one pass over the
+   * slices of the tube, without the per-value bookkeeping of the Slice setters:
+   * the changes are reported once to the synthesis and to the tracked volume
+   * of the tube. The functions are inlined in the loop, and the rounding
+   * is the one of the IBEX interval arithmetic.
+   *
+   * \note Implementation of the arithmetic on tubes, not part of the public API.
+   */
+  class TubeKernels
+  {
+    public:
+
+      /**
+       * \brief Computes \f$[y](\cdot):=f([y](\cdot))\f$
+       *
+       * \param y the tube to be updated
+       * \param f the unary interval function
+       */
+      template<typename F>
+      static void map(Tube& y, const F& f)
+      {
+        VolumeChange change(y);
+        Slice *s = y.m_first_slice;
+
+        double prev = change.tracked ? Slice::bounded_diam(*s->m_input_gate) : 0.;
+        *s->m_input_gate = f(*s->m_input_gate);
+        if(change.tracked)
+          change.add(prev, Slice::bounded_diam(*s->m_input_gate), s->m_tdomain);
+
+        for( ; s ; s = s->m_next_slice)
+        {
+          prev = change.tracked ? contribution(s) : 0.;
+          s->m_codomain = f(s->m_codomain);
+          *s->m_output_gate = f(*s->m_output_gate); // also the input gate of the next slice
+          if(change.tracked)
+            change.add(prev, contribution(s), s->m_tdomain);
+        }
+
+        values_updated(y, change);
+      }
+
+      /**
+       * \brief Computes \f$[y](\cdot):=f([y](\cdot),[x](\cdot))\f$
+       *
+       * \param y the tube to be updated
+       * \param x the second operand, with the same slicing as \f$[y](\cdot)\f$
+       * \param f the binary interval function
+       */
+      template<typename F>
+      static void map(Tube& y, const Tube& x, const F& f)
+      {
+        assert(Tube::same_slicing(y, x));
+
+        VolumeChange change(y);
+        Slice *s = y.m_first_slice;
+        const Slice *s_x = x.m_first_slice;
+
+        double prev = change.tracked ? Slice::bounded_diam(*s->m_input_gate) : 0.;
+        *s->m_input_gate = f(*s->m_input_gate, *s_x->m_input_gate);
+        if(change.tracked)
+          change.add(prev, Slice::bounded_diam(*s->m_input_gate), s->m_tdomain);
+
+        for( ; s ; s = s->m_next_slice, s_x = s_x->m_next_slice)
+        {
+          prev = change.tracked ? contribution(s) : 0.;
+          s->m_codomain = f(s->m_codomain, s_x->m_codomain);
+          *s->m_output_gate = f(*s->m_output_gate, *s_x->m_output_gate);
+          if(change.tracked)
+            change.add(prev, contribution(s), s->m_tdomain);
+        }
+
+        values_updated(y, change);
+      }
+
+    protected:
+
+      /**
+       * \struct VolumeChange
+       * \brief Accumulation of the changes of the tracked volume of a tube,
+       *        reported once at the end of a kernel
+       */
+      struct VolumeChange
+      {
+        /**
+         * \brief Starts the accumulation of the changes of a tube
+         *
+         * \param y the tube, its changes are accumulated only if its volume is tracked
+         */
+        explicit VolumeChange(const Tube& y) : tracked(y.m_tracked_volume_valid) { }
+
+        /**
+         * \brief Accumulates the change of volume of a slice
+         *
+         * \param prev previous volume
+         * \param current volume after the update
+         * \param t tdomain of the slice
+         */
+        void add(double prev, double current, const Interval& t)
+        {
+          if(prev != current)
+          {
+            dv += current - prev;
+            tdomain |= t;
+          }
+        }
+
+        const bool tracked; //!< true if the volume of the tube is tracked
+        double dv = 0.; //!< sum of the volume differences
+        Interval tdomain = Interval::EMPTY_SET; //!< hull of the tdomains of the changes
+      };
+
+      /**
+       * \brief Returns the part of the tracked volume of a tube related to a slice,
+       *        its input gate being counted with the previous slice
+       *
+       * \param s the slice
+       * \return the volume of the envelope and of the output gate
+       */
+      static double contribution(const Slice *s)
+      {
+        return s->m_tdomain.diam() * Slice::bounded_diam(s->m_codomain) + Slice::bounded_diam(*s->m_output_gate);
+      }
+
+      /**
+       * \brief Reports the changes of values to the synthesis and the tracked volume of a tube
+       *
+       * \param y the updated tube
+       * \param change the accumulated changes of volume
+       */
+      static void values_updated(Tube& y, const VolumeChange& change)
+      {
+        if(y.m_synthesis_mode == SynthesisMode::BINARY_TREE)
+          for(Slice *s = y.m_first_slice ; s ; s = s->m_next_slice)
+            if(s->m_synthesis_reference)
+            {
+              s->m_synthesis_reference->request_values_update();
+              s->m_synthesis_reference->request_integrals_update();
+            }
+
+        if(change.tracked && !change.tdomain.is_empty())
+          y.add_tracked_volume(change.dv, change.tdomain);
+      }
+  };
+}
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ *  CNCheckpoint class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "codac_CNCheckpoint.h"
+
+using namespace std;
+
+namespace codac
+{
+  CNCheckpoint::CNCheckpoint()
+  {
+
+  }
+
+  bool CNCheckpoint::is_empty() const
+  {
+    return !m_data;
+  }
+
+  int CNCheckpoint::nb_values() const
+  {
+    int n = 0;
+    if(m_data)
+      for(const auto& block : m_data->v_blocks)
+        n += block->size();
+    return n;
+  }
+
+  int CNCheckpoint::nb_new_values() const
+  {
+    return m_data ? m_data->nb_new_values : 0;
+  }
+}
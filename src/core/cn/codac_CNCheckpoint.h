@@ -0,0 +1,94 @@
+/**
+ *  \file
+ *  CNCheckpoint class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_CNCHECKPOINT_H__
+#define __CODAC_CNCHECKPOINT_H__
+
+#include <memory>
+#include <vector>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  class ContractorNetwork;
+  class CNSolver;
+
+  /**
+   * \class CNCheckpoint
+   * \brief Snapshot of the values of the domains of a ContractorNetwork,
+   *        and of its queue of active contractors.
+   *
+   * The values are stored in blocks of intervals (tubes are saved as the envelopes
+   * and gates of their slices, by blocks of CNCheckpoint::BLOCK_SIZE values).
+   * A snapshot is immutable once created: copies of a CNCheckpoint share the same
+   * data, and the blocks that did not change since the previous checkpoint of the
+   * network (or the last restored one) are shared with it instead of being copied.
+   * Along a search tree, a checkpoint thus only stores the values changed by
+   * the bisection and the propagation.
+   *
+   * \note See ContractorNetwork::checkpoint() and ContractorNetwork::restore()
+   */
+  class CNCheckpoint
+  {
+    public:
+
+      /**
+       * \brief Creates an empty checkpoint, that cannot be restored
+       */
+      CNCheckpoint();
+
+      /**
+       * \brief Returns `true` if this checkpoint does not contain any snapshot
+       *
+       * \return emptiness test
+       */
+      bool is_empty() const;
+
+      /**
+       * \brief Returns the number of intervals stored in this snapshot
+       *
+       * \return number of saved intervals
+       */
+      int nb_values() const;
+
+      /**
+       * \brief Returns the number of intervals stored by this snapshot only,
+       *        the other ones being shared with a previous checkpoint
+       *
+       * \return number of values copied when creating this checkpoint
+       */
+      int nb_new_values() const;
+
+      static const int BLOCK_SIZE = 256; //!< maximal number of values of a block
+
+    protected:
+
+      /**
+       * \struct Data
+       * \brief Immutable content of a snapshot
+       */
+      struct Data
+      {
+        const ContractorNetwork *cn = nullptr; //!< network the snapshot has been taken from
+        std::vector<std::pair<int,int> > v_domains; //!< saved domains: dense id of the domain and index of its first block
+        std::vector<std::shared_ptr<const std::vector<Interval> > > v_blocks; //!< values of the domains, blocks possibly shared with other checkpoints
+        int nb_new_values = 0; //!< number of values in the blocks created for this snapshot
+        std::vector<int> v_active_ctc; //!< dense ids of the contractors waiting for process, in queue order
+      };
+
+      std::shared_ptr<const Data> m_data; //!< shared snapshot
+
+      friend class ContractorNetwork;
+      friend class CNSolver;
+  };
+}
+
+#endif
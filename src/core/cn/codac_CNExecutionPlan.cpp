@@ -0,0 +1,92 @@
+/**
+ *  CNExecutionPlan class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "codac_CNExecutionPlan.h"
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  CNExecutionPlan::CNExecutionPlan()
+  {
+
+  }
+
+  int CNExecutionPlan::nb_ctc() const
+  {
+    return m_v_ctc.size();
+  }
+
+  int CNExecutionPlan::nb_dom() const
+  {
+    return m_v_domains.size();
+  }
+
+  const vector<Contractor*>& CNExecutionPlan::contractors() const
+  {
+    return m_v_ctc;
+  }
+
+  int CNExecutionPlan::run(int max_sweeps)
+  {
+    if(!m_cn)
+      throw Exception(__func__, "empty execution plan");
+
+    if(m_cn->nb_ctc() != m_cn_nb_ctc || m_cn->nb_dom() != m_cn_nb_dom)
+      throw Exception(__func__, "the contractor network has changed since its compilation");
+
+    if(m_v_ctc.empty() || max_sweeps == 0)
+      return 0;
+
+    for(size_t i = 0 ; i < m_v_domains.size() ; i++)
+      m_v_volumes[i] = m_v_domains[i]->compute_volume();
+
+    const int n = m_v_ctc.size();
+    int nb_sweeps = 0;
+    bool fixed_point;
+
+    do
+    {
+      nb_sweeps++;
+
+      // Forward
+      for(int i = 0 ; i < n ; i++)
+        apply(i);
+
+      // Backward: the last forward contractor has just been called
+      for(int i = n-2 ; i >= 0 ; i--)
+        apply(i);
+
+      // Looking for fixed point
+      fixed_point = true;
+      for(size_t i = 0 ; i < m_v_domains.size() ; i++)
+      {
+        double current_volume = m_v_domains[i]->compute_volume();
+        fixed_point &= !((current_volume/m_v_volumes[i]) < 1.-m_fixedpoint_ratio);
+        m_v_volumes[i] = current_volume;
+      }
+
+    } while(!fixed_point && (max_sweeps < 0 || nb_sweeps < max_sweeps));
+
+    return nb_sweeps;
+  }
+
+  void CNExecutionPlan::apply(int i)
+  {
+    if(m_v_box_id[i] < 0)
+      m_v_ctc[i]->contract();
+
+    else // no allocation of a temporary box
+      m_v_ctc[i]->contract_ibex(m_v_boxes[m_v_box_id[i]]);
+  }
+}
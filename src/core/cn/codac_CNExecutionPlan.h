@@ -0,0 +1,103 @@
+/**
+ *  \file
+ *  CNExecutionPlan class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_CNEXECUTIONPLAN_H__
+#define __CODAC_CNEXECUTIONPLAN_H__
+
+#include <vector>
+#include "codac_IntervalVector.h"
+
+namespace codac
+{
+  class Domain;
+  class Contractor;
+  class ContractorNetwork;
+
+  /**
+   * \class CNExecutionPlan
+   * \brief Static schedule of the contractors of a ContractorNetwork.
+   *
+   * The plan is computed once from the topology of the graph (see ContractorNetwork::compile()):
+   * contractors are ordered by a breadth-first traversal of the graph, and called
+   * in forward/backward sweeps until a fixed point is reached on the volumes
+   * of their domains. Contrary to ContractorNetwork::contract(), a run does not
+   * involve any hashing, queue of active contractors, nor memory allocation
+   * on the network side, which makes it suitable for repeated solves of a
+   * same problem with new values of the domains.
+   *
+   * \note The plan refers to the domains and contractors of the network: it
+   *       becomes invalid if the network is modified or destroyed.
+   */
+  class CNExecutionPlan
+  {
+    public:
+
+      /**
+       * \brief Creates an empty plan, that cannot be run
+       */
+      CNExecutionPlan();
+
+      /**
+       * \brief Returns the number of contractors called by a sweep
+       *
+       * \return number of contractors
+       */
+      int nb_ctc() const;
+
+      /**
+       * \brief Returns the number of domains monitored for the fixed point detection
+       *
+       * \return number of domains
+       */
+      int nb_dom() const;
+
+      /**
+       * \brief Returns the contractors of the plan, in the order of the forward sweep
+       *
+       * \return ordered list of pointers to the contractors
+       */
+      const std::vector<Contractor*>& contractors() const;
+
+      /**
+       * \brief Runs the forward/backward sweeps on the current values of the domains
+       *
+       * \param max_sweeps maximal number of forward/backward sweeps, or \f$-1\f$
+       *        (default value) to run until a fixed point
+       * \return the number of sweeps that have been performed
+       */
+      int run(int max_sweeps = -1);
+
+    protected:
+
+      /**
+       * \brief Calls a contractor of the plan
+       *
+       * \param i index of the contractor in the plan
+       */
+      void apply(int i);
+
+    protected:
+
+      const ContractorNetwork *m_cn = nullptr; //!< network the plan has been compiled from
+      int m_cn_nb_ctc = 0, m_cn_nb_dom = 0; //!< size of the network at compilation, for invalidation
+      float m_fixedpoint_ratio = 0.; //!< fixed point ratio of the network at compilation
+
+      std::vector<Contractor*> m_v_ctc; //!< contractors, in the order of the forward sweep
+      std::vector<int> m_v_box_id; //!< for each contractor, index of its temporary box, or -1
+      std::vector<IntervalVector> m_v_boxes; //!< preallocated boxes for IBEX contractors on heterogeneous domains
+      std::vector<Domain*> m_v_domains; //!< domains monitored for the fixed point detection
+      std::vector<double> m_v_volumes; //!< last volumes of the monitored domains
+
+      friend class ContractorNetwork;
+  };
+}
+
+#endif
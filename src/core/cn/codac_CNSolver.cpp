@@ -0,0 +1,338 @@
+/**
+ *  CNSolver class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <ibex_LargestFirst.h>
+#include "codac_CNSolver.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Definition
+
+    CNSolver::CNSolver(ContractorNetwork& cn, const vector<Domain>& v_bisected)
+      : m_priority([](const IntervalVector& x) { return x.max_diam(); })
+    {
+      add_instance(cn, v_bisected);
+    }
+
+    void CNSolver::add_instance(ContractorNetwork& cn, const vector<Domain>& v_bisected)
+    {
+      if(v_bisected.empty())
+        throw Exception(__func__, "no variable to bisect");
+
+      Instance inst;
+      inst.cn = &cn;
+      int n = 0;
+
+      for(const auto& dom : v_bisected)
+      {
+        if(dom.type() != Domain::Type::T_INTERVAL && dom.type() != Domain::Type::T_INTERVAL_VECTOR)
+          throw Exception(__func__, "only Interval and IntervalVector domains can be bisected");
+
+        unordered_map<DomainHashcode,Domain*>::const_iterator it = cn.m_map_domains.find(DomainHashcode(dom));
+        if(it == cn.m_map_domains.end())
+          throw Exception(__func__, "bisected domain cannot be found in the CN");
+
+        inst.v_bisected.push_back(it->second);
+        n += dom.type() == Domain::Type::T_INTERVAL ? 1 : dom.interval_vector().size();
+      }
+
+      for(const auto& other : m_v_instances)
+        if(other.cn == &cn)
+          throw Exception(__func__, "each instance must have its own contractor network");
+
+      if(!m_v_instances.empty() && n != get_box(m_v_instances[0]).size())
+        throw Exception(__func__, "bisected domains differ from the ones of the first instance");
+
+      m_v_instances.push_back(inst);
+    }
+
+    int CNSolver::nb_instances() const
+    {
+      return m_v_instances.size();
+    }
+
+    void CNSolver::set_strategy(SearchStrategy strategy)
+    {
+      m_strategy = strategy;
+    }
+
+    void CNSolver::set_priority(const function<double(const IntervalVector&)>& priority)
+    {
+      assert(priority);
+      m_priority = priority;
+    }
+
+  // Solving
+
+    map<SetValue,list<IntervalVector>> CNSolver::solve(double precision, bool return_out)
+    {
+      assert(precision > 0.);
+
+      map<SetValue,list<IntervalVector>> boxes{
+        // SetValue::IN is not possible from contractors
+        {SetValue::OUT, {}},
+        {SetValue::UNKNOWN, {}},
+      };
+
+      m_deque.clear();
+      m_heap = priority_queue<Node>();
+      m_nb_processed_boxes = 0;
+
+      for(auto& inst : m_v_instances)
+        inst.root = inst.cn->checkpoint();
+
+      Node root_node;
+      root_node.box = get_box(m_v_instances[0]);
+      root_node.priority = m_priority(root_node.box);
+      push_node(std::move(root_node));
+
+      mutex mtx;
+      condition_variable cv;
+      int nb_busy = 0; // number of boxes currently processed
+      bool cancelled = false;
+      exception_ptr error; // first exception raised by a contraction, rethrown at the end
+
+      auto worker = [&](Instance& inst)
+      {
+        vector<Node> children;
+        map<SetValue,list<IntervalVector>> local_boxes;
+        unique_lock<mutex> lock(mtx);
+
+        while(true)
+        {
+          // Waiting for a box, or for the end of the processes that may produce new ones
+          cv.wait(lock, [&]() { return !no_node() || nb_busy == 0; });
+          if(no_node())
+            break;
+
+          Node node = pop_node();
+          if(cancelled)
+          {
+            boxes[SetValue::UNKNOWN].push_back(node.box);
+            continue;
+          }
+
+          nb_busy++;
+          m_nb_processed_boxes++;
+          lock.unlock();
+
+          children.clear();
+          local_boxes.clear();
+          exception_ptr process_error;
+          try
+          {
+            process(inst, node, precision, return_out, children, local_boxes);
+          }
+          catch(...)
+          {
+            process_error = current_exception();
+            children.clear();
+          }
+          bool ctc_cancelled = process_error || inst.cn->status() == ContractionStatus::CANCELLED;
+
+          lock.lock();
+          nb_busy--;
+          cancelled |= ctc_cancelled;
+          if(process_error && !error)
+            error = process_error;
+          for(auto& child : children)
+            push_node(std::move(child));
+          for(auto& b : local_boxes)
+            boxes[b.first].splice(boxes[b.first].end(), b.second);
+          cv.notify_all();
+        }
+
+        cv.notify_all();
+      };
+
+      if(m_v_instances.size() == 1)
+        worker(m_v_instances[0]);
+
+      else
+      {
+        vector<thread> v_threads;
+        for(auto& inst : m_v_instances)
+          v_threads.push_back(thread(worker, ref(inst)));
+        for(auto& t : v_threads)
+          t.join();
+      }
+
+      // The networks are left as they were before solving
+      for(auto& inst : m_v_instances)
+      {
+        inst.cn->restore(inst.root);
+        inst.root = CNCheckpoint();
+      }
+
+      if(error)
+        rethrow_exception(error);
+
+      return boxes;
+    }
+
+    int CNSolver::nb_processed_boxes() const
+    {
+      return m_nb_processed_boxes;
+    }
+
+  // Protected methods
+
+    void CNSolver::push_node(Node&& node)
+    {
+      if(m_strategy == SearchStrategy::BEST_FIRST)
+        m_heap.push(std::move(node));
+      else
+        m_deque.push_back(std::move(node));
+    }
+
+    CNSolver::Node CNSolver::pop_node()
+    {
+      Node node;
+
+      switch(m_strategy)
+      {
+        case SearchStrategy::DEPTH_FIRST:
+          node = std::move(m_deque.back());
+          m_deque.pop_back();
+          break;
+
+        case SearchStrategy::BREADTH_FIRST:
+          node = std::move(m_deque.front());
+          m_deque.pop_front();
+          break;
+
+        case SearchStrategy::BEST_FIRST:
+          node = m_heap.top();
+          m_heap.pop();
+          break;
+
+        default:
+          assert(false && "unhandled case");
+      }
+
+      return node;
+    }
+
+    bool CNSolver::no_node() const
+    {
+      return m_strategy == SearchStrategy::BEST_FIRST ? m_heap.empty() : m_deque.empty();
+    }
+
+    IntervalVector CNSolver::get_box(const Instance& inst)
+    {
+      int n = 0;
+      for(const auto& dom : inst.v_bisected)
+        n += dom->type() == Domain::Type::T_INTERVAL ? 1 : dom->interval_vector().size();
+
+      IntervalVector box(n);
+      int i = 0;
+
+      for(const auto& dom : inst.v_bisected)
+      {
+        if(dom->type() == Domain::Type::T_INTERVAL)
+          box[i++] = dom->interval();
+
+        else
+        {
+          box.put(i, dom->interval_vector());
+          i += dom->interval_vector().size();
+        }
+      }
+
+      return box;
+    }
+
+    void CNSolver::set_box(Instance& inst, const IntervalVector& box)
+    {
+      int i = 0;
+
+      for(const auto& dom : inst.v_bisected)
+      {
+        if(dom->type() == Domain::Type::T_INTERVAL)
+          dom->interval() = box[i++];
+
+        else
+        {
+          int n = dom->interval_vector().size();
+          dom->interval_vector() = box.subvector(i, i+n-1);
+          i += n;
+        }
+
+        inst.cn->trigger_ctc_related_to_dom(dom);
+      }
+    }
+
+    void CNSolver::process(Instance& inst, const Node& node, double precision, bool return_out,
+      vector<Node>& children, map<SetValue,list<IntervalVector>>& results) const
+    {
+      ContractorNetwork& cn = *inst.cn;
+
+      // Starting from the contractions of the parent box, when they have been computed
+      // on this network, otherwise from the initial state
+      if(!node.parent.is_empty() && node.parent.m_data->cn == &cn)
+        cn.restore(node.parent);
+      else
+        cn.restore(inst.root);
+
+      set_box(inst, node.box);
+      cn.contract();
+
+      if(cn.emptiness())
+      {
+        if(return_out)
+          results[SetValue::OUT].push_back(node.box);
+        return;
+      }
+
+      IntervalVector box = get_box(inst);
+
+      if(return_out)
+      {
+        IntervalVector *diff;
+        int n = node.box.diff(box, diff);
+        for(int i = 0 ; i < n ; i++)
+          if(!diff[i].is_empty())
+            results[SetValue::OUT].push_back(diff[i]);
+        delete[] diff;
+      }
+
+      if(box.max_diam() < precision || cn.status() == ContractionStatus::CANCELLED)
+      {
+        results[SetValue::UNKNOWN].push_back(box);
+        return;
+      }
+
+      LargestFirst bisector(0.);
+      pair<IntervalVector,IntervalVector> p = bisector.bisect(box);
+      // Shared by the two subproblems, and released once both are processed.
+      // The network has been restored from node.parent: only the blocks of
+      // values contracted since then are copied, the others are shared.
+      const CNCheckpoint checkpoint = cn.checkpoint();
+
+      Node first, second;
+      first.box = p.first;
+      first.parent = checkpoint;
+      first.priority = m_priority(first.box);
+      second.box = p.second;
+      second.parent = checkpoint;
+      second.priority = m_priority(second.box);
+
+      children.push_back(std::move(first));
+      children.push_back(std::move(second));
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ *  \file
+ *  CNSolver class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_CNSOLVER_H__
+#define __CODAC_CNSOLVER_H__
+
+#include <map>
+#include <list>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <functional>
+#include "codac_Set.h"
+#include "codac_IntervalVector.h"
+#include "codac_ContractorNetwork.h"
+
+namespace codac
+{
+  /**
+   * \enum SearchStrategy
+   * \brief Order in which the boxes of a branch-and-prune are explored
+   */
+  enum class SearchStrategy
+  {
+    DEPTH_FIRST,   ///< last bisected boxes first (low memory, quick first solutions)
+    BREADTH_FIRST, ///< boxes processed in their order of creation (uniform refinement)
+    BEST_FIRST     ///< box of highest priority first, see CNSolver::set_priority()
+  };
+
+  /**
+   * \class CNSolver
+   * \brief Branch-and-prune algorithm on top of a ContractorNetwork.
+   *
+   * Some Interval or IntervalVector domains of the network are declared as
+   * bisectable variables. The solver alternates propagations of the network
+   * and bisections of these variables, until the boxes are smaller than a
+   * given precision. The network is saved with ContractorNetwork::checkpoint()
+   * before each bisection, so that a subproblem starts from the contractions
+   * obtained on its parent box. This checkpoint only copies the values changed
+   * since the parent's one, and is released once both subproblems are processed.
+   *
+   * An exception thrown by a contractor cancels the solving: the network is
+   * restored in its initial state and the exception is rethrown by solve().
+   *
+   * Subproblems can be solved in parallel: each additional instance of the
+   * network (see add_instance()) is run by its own thread.
+   */
+  class CNSolver
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a branch-and-prune solver
+       *
+       * \param cn the contractor network defining the problem
+       * \param v_bisected Interval or IntervalVector domains of `cn` to be bisected,
+       *        their current values define the initial box
+       */
+      CNSolver(ContractorNetwork& cn, const std::vector<Domain>& v_bisected);
+
+      /**
+       * \brief Adds another instance of the same problem, run by another thread.
+       *
+       * The network has to be built as the first one (same domains and contractors,
+       * added in the same order), but it must not share with the other
+       * instances any domain or any non-reentrant contractor (such as a
+       * CtcFunction), since they are called simultaneously.
+       *
+       * \param cn a copy of the contractor network defining the problem
+       * \param v_bisected its domains corresponding to the ones of the first instance
+       */
+      void add_instance(ContractorNetwork& cn, const std::vector<Domain>& v_bisected);
+
+      /**
+       * \brief Returns the number of instances of the problem,
+       *        that is the number of threads used by the solver
+       *
+       * \return number of instances
+       */
+      int nb_instances() const;
+
+      /**
+       * \brief Sets the exploration strategy
+       *
+       * \param strategy order of exploration, depth first by default
+       */
+      void set_strategy(SearchStrategy strategy);
+
+      /**
+       * \brief Sets the priority of the boxes, for the best-first strategy
+       *
+       * \param priority function returning the priority of a box: boxes of
+       *        highest priority are processed first (by default, the largest
+       *        diameter of the box)
+       */
+      void set_priority(const std::function<double(const IntervalVector&)>& priority);
+
+      /// @}
+      /// \name Solving
+      /// @{
+
+      /**
+       * \brief Computes a paving of the bisected variables.
+       *
+       * The networks are restored to their initial state at the end of the solving.
+       *
+       * \param precision boxes smaller than this value are not bisected anymore
+       * \param return_out if true, the parts of boxes removed by the propagations are returned
+       * \return a map of lists of boxes. Keys of the map are OUT/UNKNOWN, as a contractor network
+       *         cannot prove that a box is inside the solution set.
+       */
+      std::map<SetValue,std::list<IntervalVector>> solve(double precision, bool return_out = true);
+
+      /**
+       * \brief Returns the number of boxes processed by the last solving
+       *
+       * \return number of propagations
+       */
+      int nb_processed_boxes() const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \struct Instance
+       * \brief A contractor network and its bisectable domains
+       */
+      struct Instance
+      {
+        ContractorNetwork *cn; //!< the network
+        std::vector<Domain*> v_bisected; //!< its bisectable domains (Interval or IntervalVector)
+        CNCheckpoint root; //!< state of the network before solving
+      };
+
+      /**
+       * \struct Node
+       * \brief Subproblem waiting for process
+       */
+      struct Node
+      {
+        IntervalVector box = IntervalVector(1); //!< values of the bisected variables
+        CNCheckpoint parent; //!< state of the network after the contraction of the parent box
+        double priority = 0.; //!< priority of the box (best-first strategy)
+
+        /**
+         * \brief Defines an order on the nodes for the priority queue
+         */
+        bool operator<(const Node& n) const { return priority < n.priority; }
+      };
+
+      /**
+       * \brief Pushes a subproblem in the container defined by the strategy
+       *
+       * \param node the subproblem
+       */
+      void push_node(Node&& node);
+
+      /**
+       * \brief Pops the next subproblem to be processed
+       *
+       * \return the subproblem
+       */
+      Node pop_node();
+
+      /**
+       * \brief Returns `true` if there is no subproblem waiting for process
+       *
+       * \return emptiness test
+       */
+      bool no_node() const;
+
+      /**
+       * \brief Gets the values of the bisected variables of an instance
+       *
+       * \param inst the instance
+       * \return the box of bisected variables
+       */
+      static IntervalVector get_box(const Instance& inst);
+
+      /**
+       * \brief Sets the values of the bisected variables of an instance,
+       *        and triggers the related contractors
+       *
+       * \param inst the instance
+       * \param box the box of bisected variables
+       */
+      static void set_box(Instance& inst, const IntervalVector& box);
+
+      /**
+       * \brief Contracts a subproblem and bisects it
+       *
+       * \param inst the instance used for the contraction
+       * \param node the subproblem
+       * \param precision precision of the paving
+       * \param return_out if true, the removed parts of the box are returned
+       * \param children resulting subproblems to be processed
+       * \param results resulting OUT/UNKNOWN boxes
+       */
+      void process(Instance& inst, const Node& node, double precision, bool return_out,
+        std::vector<Node>& children, std::map<SetValue,std::list<IntervalVector>>& results) const;
+
+    protected:
+
+      std::vector<Instance> m_v_instances; //!< identical instances of the problem, one per thread
+      SearchStrategy m_strategy = SearchStrategy::DEPTH_FIRST; //!< exploration strategy
+      std::function<double(const IntervalVector&)> m_priority; //!< priority of the boxes (best-first strategy)
+      std::deque<Node> m_deque; //!< subproblems waiting for process (depth-first and breadth-first strategies)
+      std::priority_queue<Node> m_heap; //!< subproblems waiting for process (best-first strategy)
+      int m_nb_processed_boxes = 0; //!< number of propagations of the last solving
+  };
+}
+
+#endif
@@ -0,0 +1,37 @@
+/**
+ *  ContractionBudget and CancellationToken classes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "codac_ContractionBudget.h"
+
+using namespace std;
+
+namespace codac
+{
+  CancellationToken::CancellationToken()
+    : m_cancelled(make_shared<atomic<bool> >(false))
+  {
+
+  }
+
+  void CancellationToken::cancel()
+  {
+    m_cancelled->store(true, memory_order_relaxed);
+  }
+
+  bool CancellationToken::is_cancelled() const
+  {
+    return m_cancelled->load(memory_order_relaxed);
+  }
+
+  void CancellationToken::reset()
+  {
+    m_cancelled->store(false, memory_order_relaxed);
+  }
+}
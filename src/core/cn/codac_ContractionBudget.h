@@ -0,0 +1,86 @@
+/**
+ *  \file
+ *  ContractionBudget and CancellationToken classes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_CONTRACTIONBUDGET_H__
+#define __CODAC_CONTRACTIONBUDGET_H__
+
+#include <atomic>
+#include <memory>
+#include <limits>
+
+namespace codac
+{
+  /**
+   * \class CancellationToken
+   * \brief Flag that can be raised from any thread for stopping a propagation in progress.
+   *
+   * Copies of a token share the same flag.
+   */
+  class CancellationToken
+  {
+    public:
+
+      /**
+       * \brief Creates a new (not cancelled) token
+       */
+      CancellationToken();
+
+      /**
+       * \brief Requests the cancellation of the propagations using this token
+       */
+      void cancel();
+
+      /**
+       * \brief Returns `true` if the cancellation has been requested
+       *
+       * \return cancellation status
+       */
+      bool is_cancelled() const;
+
+      /**
+       * \brief Clears the cancellation request, so that the token can be reused
+       */
+      void reset();
+
+    protected:
+
+      std::shared_ptr<std::atomic<bool> > m_cancelled; //!< flag shared by the copies of the token
+  };
+
+  /**
+   * \struct ContractionBudget
+   * \brief Limits of a propagation process in a ContractorNetwork.
+   *
+   * The propagation stops as soon as one of the limits is reached,
+   * even if a fixed point has not been obtained.
+   */
+  struct ContractionBudget
+  {
+    double max_duration = std::numeric_limits<double>::infinity(); //!< wall-clock time limit in seconds (steady clock)
+    int max_ctc_calls = -1; //!< maximum number of contractor calls, -1 for no limit
+    int max_dom_contractions = -1; //!< maximum number of contractions propagated from each domain, -1 for no limit
+    CancellationToken cancellation; //!< token that can be triggered from another thread
+  };
+
+  /**
+   * \enum ContractionStatus
+   * \brief Reason why the last propagation process stopped
+   */
+  enum class ContractionStatus
+  {
+    FIXED_POINT, //!< no more contractor to apply (fixed point, up to the per-domain limits)
+    TIME_LIMIT, //!< the wall-clock time limit has been reached
+    CALLS_LIMIT, //!< the maximum number of contractor calls has been reached
+    CANCELLED //!< the cancellation token has been triggered
+  };
+}
+
+#endif
@@ -133,12 +133,7 @@ namespace codac
   const vector<Domain*> Contractor::domains() const
   {
     if(m_type == Type::T_CN)
-    {
-      vector<Domain*> v_dom; // building a vector of domains from the CN map
-      for(const auto& dom : m_cn_ctc.get().m_map_domains)
-        v_dom.push_back(dom.second);
-      return v_dom;
-    }
+      return m_cn_ctc.get().m_v_domains;
 
     else
       return m_v_domains;
@@ -223,125 +218,8 @@ namespace codac
       // Case: list of heterogeneous components
       else
       {
-        for(int j = 0 ; j < 3 ; j++) // to possibly deal with 3 subdomains of a Slice (gates + envelope)
-        {
-          bool at_least_one_slice = false;
-          // if this ^ stays false, then the for loop will break after the first iteration
-
-          // Building a temporary box for the contraction
-          
-            IntervalVector box(m_static_ctc.get().nb_var);
-
-            int i = 0;
-            for(auto& dom : m_v_domains)
-            {
-              switch(dom->type())
-              {
-                case Domain::Type::T_INTERVAL:
-                  box[i] = dom->interval();
-                  i++;
-                  break;
-
-                case Domain::Type::T_INTERVAL_VECTOR:
-                  assert(false && "interval vectors should not be handled here");
-                  box.put(i, dom->interval_vector());
-                  i+=dom->interval_vector().size();
-                  break;
-
-                case Domain::Type::T_SLICE:
-                  switch(j)
-                  {
-                    case 0: // we start from the envelope
-                      box[i] = dom->slice().codomain();
-                      break;
-                    
-                    // Then the gates
-                    case 1:
-                      box[i] = dom->slice().input_gate();
-                      break;
-                      
-                    case 2:
-                      box[i] = dom->slice().output_gate();
-                      break;
-
-                    default:
-                      assert(false && "Slice domain already treated");
-                  }
-                  i++;
-                  at_least_one_slice = true;
-                  break;
-
-                case Domain::Type::T_TUBE:
-                case Domain::Type::T_TUBE_VECTOR:
-                  assert(false && "dynamic domains should not be handled here");
-                  break;
-
-                default:
-                  assert(false && "unhandled case");
-              }
-            }
-
-            assert(i == m_static_ctc.get().nb_var);
-
-          // Contracting
-
-            m_static_ctc.get().contract(box);
-            
-          // Updating the domains (reverse operation)
-
-            i = 0;
-            for(auto& dom : m_v_domains)
-            {
-              switch(dom->type())
-              {
-                case Domain::Type::T_INTERVAL:
-                {
-                  dom->interval() = box[i];
-                  i++;
-                }
-                break;
-
-                case Domain::Type::T_INTERVAL_VECTOR:
-                {
-                  int vector_size = dom->interval_vector().size();
-                  dom->interval_vector() = box.subvector(i, i+vector_size);
-                  i+=vector_size;
-                }
-                break;
-
-                case Domain::Type::T_SLICE:
-                {
-                  switch(j)
-                  {
-                    case 0:
-                      dom->slice().set_envelope(box[i]);
-                      break;
-
-                    case 1:
-                      dom->slice().set_input_gate(box[i]);
-                      break;
-
-                    case 2:
-                      dom->slice().set_output_gate(box[i]);
-                      break;
-
-                    default:
-                      assert(false && "Slice domain already treated");
-                  }
-                  i++;
-                }
-                break;
-
-                default:
-                  assert(false && "unhandled case");
-              }
-            }
-
-            assert(i == m_static_ctc.get().nb_var);
-
-          if(!at_least_one_slice)
-            break;
-        }
+        IntervalVector box(m_static_ctc.get().nb_var); // temporary box for the contraction
+        contract_ibex(box);
       }
     }
 
@@ -408,6 +286,130 @@ namespace codac
       assert(false && "unhandled case");
   }
   
+  void Contractor::contract_ibex(IntervalVector& box)
+  {
+    assert(m_type == Type::T_IBEX);
+    assert(box.size() == m_static_ctc.get().nb_var);
+
+    for(int j = 0 ; j < 3 ; j++) // to possibly deal with 3 subdomains of a Slice (gates + envelope)
+    {
+      bool at_least_one_slice = false;
+      // if this ^ stays false, then the for loop will break after the first iteration
+
+      // Filling the box for the contraction
+
+        int i = 0;
+        for(auto& dom : m_v_domains)
+        {
+          switch(dom->type())
+          {
+            case Domain::Type::T_INTERVAL:
+              box[i] = dom->interval();
+              i++;
+              break;
+
+            case Domain::Type::T_INTERVAL_VECTOR:
+              assert(false && "interval vectors should not be handled here");
+              box.put(i, dom->interval_vector());
+              i+=dom->interval_vector().size();
+              break;
+
+            case Domain::Type::T_SLICE:
+              switch(j)
+              {
+                case 0: // we start from the envelope
+                  box[i] = dom->slice().codomain();
+                  break;
+                
+                // Then the gates
+                case 1:
+                  box[i] = dom->slice().input_gate();
+                  break;
+                  
+                case 2:
+                  box[i] = dom->slice().output_gate();
+                  break;
+
+                default:
+                  assert(false && "Slice domain already treated");
+              }
+              i++;
+              at_least_one_slice = true;
+              break;
+
+            case Domain::Type::T_TUBE:
+            case Domain::Type::T_TUBE_VECTOR:
+              assert(false && "dynamic domains should not be handled here");
+              break;
+
+            default:
+              assert(false && "unhandled case");
+          }
+        }
+
+        assert(i == m_static_ctc.get().nb_var);
+
+      // Contracting
+
+        m_static_ctc.get().contract(box);
+        
+      // Updating the domains (reverse operation)
+
+        i = 0;
+        for(auto& dom : m_v_domains)
+        {
+          switch(dom->type())
+          {
+            case Domain::Type::T_INTERVAL:
+            {
+              dom->interval() = box[i];
+              i++;
+            }
+            break;
+
+            case Domain::Type::T_INTERVAL_VECTOR:
+            {
+              int vector_size = dom->interval_vector().size();
+              dom->interval_vector() = box.subvector(i, i+vector_size);
+              i+=vector_size;
+            }
+            break;
+
+            case Domain::Type::T_SLICE:
+            {
+              switch(j)
+              {
+                case 0:
+                  dom->slice().set_envelope(box[i]);
+                  break;
+
+                case 1:
+                  dom->slice().set_input_gate(box[i]);
+                  break;
+
+                case 2:
+                  dom->slice().set_output_gate(box[i]);
+                  break;
+
+                default:
+                  assert(false && "Slice domain already treated");
+              }
+              i++;
+            }
+            break;
+
+            default:
+              assert(false && "unhandled case");
+          }
+        }
+
+        assert(i == m_static_ctc.get().nb_var);
+
+      if(!at_least_one_slice)
+        break;
+    }
+  }
+
   const string Contractor::name() const
   {
     switch(type())
@@ -442,6 +444,26 @@ namespace codac
   {
     m_name = name;
   }
+
+  const ContractorProfile Contractor::profile() const
+  {
+    ContractorProfile p;
+    p.ctc_id = m_ctc_id;
+    p.name = name();
+    p.nb_calls = m_nb_calls;
+    p.nb_contractions = m_nb_contractions;
+    p.time = m_cumulated_time;
+    p.volume_reduction = m_volume_reduction;
+    return p;
+  }
+
+  void Contractor::reset_profile()
+  {
+    m_nb_calls = 0;
+    m_nb_contractions = 0;
+    m_cumulated_time = 0.;
+    m_volume_reduction = 0.;
+  }
   
   ostream& operator<<(ostream& str, const Contractor& x)
   {
@@ -30,11 +30,26 @@ namespace codac
   class DynCtc;
   class ContractorNetwork;
 
+  /**
+   * \struct ContractorProfile
+   * \brief Statistics on the calls of a Contractor during the propagations
+   *        of a ContractorNetwork, when the profiling is enabled
+   */
+  struct ContractorProfile
+  {
+    int ctc_id = 0; //!< identifier of the Contractor
+    std::string name; //!< name of the Contractor
+    int nb_calls = 0; //!< number of calls
+    int nb_contractions = 0; //!< number of calls that reduced the volume of the domains
+    double time = 0.; //!< cumulated wall-clock time of the calls, in seconds
+    double volume_reduction = 0.; //!< cumulated volume removed from the domains
+  };
+
   class Contractor
   {
     public:
 
-      enum class Type { T_COMPONENT, T_EQUALITY, T_IBEX, T_CODAC, T_CN };
+      enum class Type { T_COMPONENT, T_EQUALITY, T_IBEX, T_CODAC, T_CN, NB_TYPES /* number of types, not a type */ };
 
       Contractor(Type type, const std::vector<Domain*>& v_domains);
       Contractor(Ctc& ctc, const std::vector<Domain*>& v_domains);
@@ -63,11 +78,22 @@ namespace codac
       const std::string name() const;
       void set_name(const std::string& name);
 
+      const ContractorProfile profile() const;
+      void reset_profile();
+
       friend std::ostream& operator<<(std::ostream& str, const Contractor& x);
 
 
     protected:
 
+      /**
+       * \brief Contracts the heterogeneous domains of an IBEX contractor,
+       *        through a box of `ibex_ctc().nb_var` components provided by the caller
+       *
+       * \param box temporary box, its values are overwritten
+       */
+      void contract_ibex(IntervalVector& box);
+
       const Type m_type;
       bool m_active = true;
 
@@ -82,10 +108,18 @@ namespace codac
 
       std::string m_name;
       int m_ctc_id;
+      int m_cn_id = -1; //!< dense index of this contractor in its ContractorNetwork
+
+      int m_nb_calls = 0;
+      int m_nb_contractions = 0;
+      double m_cumulated_time = 0.;
+      double m_volume_reduction = 0.;
 
       static int ctc_counter;
       
       friend class ContractorHashcode;
+      friend class ContractorNetwork;
+      friend class CNExecutionPlan;
   };
 }
 
@@ -29,10 +29,10 @@ namespace codac
 
     ContractorNetwork::~ContractorNetwork()
     {
-      for(auto& dom : m_map_domains)
-        delete dom.second;
-      for(auto& ctc : m_map_ctc)
-        delete ctc.second;
+      for(auto& dom : m_v_domains)
+        delete dom;
+      for(auto& ctc : m_v_ctc)
+        delete ctc;
 
       if(m_ctc_deriv)
         delete m_ctc_deriv;
@@ -40,18 +40,18 @@ namespace codac
 
     int ContractorNetwork::nb_ctc() const
     {
-      return m_map_ctc.size();
+      return m_v_ctc.size();
     }
 
     int ContractorNetwork::nb_dom() const
     {
-      return m_map_domains.size();
+      return m_v_domains.size();
     }
     
     bool ContractorNetwork::emptiness() const
     {
-      for(auto& dom : m_map_domains)
-        if(dom.second->is_empty())
+      for(auto& dom : m_v_domains)
+        if(dom->is_empty())
           return true;
 
       return false;
@@ -406,9 +406,9 @@ namespace codac
       Contractor *ctc_ptr = add_ctc(cn);
 
       // Sharing domains from sub_cn to cn
-      for(auto& dom : cn.m_map_domains)
+      for(auto& dom : cn.m_v_domains)
       {
-        Domain* ad = add_dom(*dom.second);
+        Domain* ad = add_dom(*dom);
         ad->add_ctc(ctc_ptr);
       }
     }
@@ -434,12 +434,19 @@ namespace codac
       if(ad.is_empty())
         throw Exception(__func__, "domain already empty when added to the CN");
 
+      // Links to this domain may be added by the caller
+      m_adjacency_valid = false;
+
       DomainHashcode hash(ad);
-      if(m_map_domains.find(hash) != m_map_domains.end())
-        return m_map_domains[hash];
+      unordered_map<DomainHashcode,Domain*>::const_iterator it = m_map_domains.find(hash);
+      if(it != m_map_domains.end())
+        return it->second;
     
       Domain *new_dom = new Domain(ad);
-      m_map_domains[hash] = new_dom;
+      new_dom->m_cn_id = m_v_domains.size();
+      m_v_domains.push_back(new_dom);
+      m_map_domains.emplace(hash, new_dom);
+      m_v_new_domains.push_back(new_dom);
 
       // And add possible dependencies
 
@@ -521,15 +528,19 @@ namespace codac
 
     Contractor* ContractorNetwork::add_ctc(const Contractor& ac)
     {
+      m_adjacency_valid = false;
+
       ContractorHashcode hash(ac);
-      map<ContractorHashcode,Contractor*>::iterator it = m_map_ctc.find(hash);
+      unordered_map<ContractorHashcode,Contractor*>::const_iterator it = m_map_ctc.find(hash);
 
       if(it == m_map_ctc.end())
       {
         // todo: trigger only "contracting" contractors?
         Contractor *new_ctc = new Contractor(ac);
-        m_map_ctc[hash] = new_ctc;
-        add_ctc_to_queue(new_ctc, m_deque);
+        new_ctc->m_cn_id = m_v_ctc.size();
+        m_v_ctc.push_back(new_ctc);
+        m_map_ctc.emplace(std::move(hash), new_ctc);
+        push_active_ctc(new_ctc);
         return new_ctc;
       }
 
@@ -13,6 +13,8 @@
 #define __CODAC_CONTRACTORNETWORK_H__
 
 #include <deque>
+#include <chrono>
+#include <cstdint>
 #include <initializer_list>
 #include <unordered_map>
 #include "codac_Ctc.h"
@@ -21,6 +23,10 @@
 #include "codac_CtcDeriv.h"
 #include "codac_Hashcode.h"
 #include "codac_Contractor.h"
+#include "codac_ContractorScheduler.h"
+#include "codac_ContractionBudget.h"
+#include "codac_CNCheckpoint.h"
+#include "codac_CNExecutionPlan.h"
 #include "codac_Variable.h"
 
 namespace ibex
@@ -239,10 +245,11 @@ namespace codac
       /**
        * \brief Launch the contraction process
        *
-       * Contractions are performed until a fixed point has been reached on the whole graph.
+       * Contractions are performed until a fixed point has been reached on the whole graph,
+       * or until one of the limits defined by set_budget() has been reached (see status()).
        *
        * \param verbose verbose mode, `false` by default
-       * \return the computation time in seconds
+       * \return the computation time in seconds (wall-clock)
        */
       double contract(bool verbose = false);
 
@@ -265,14 +272,90 @@ namespace codac
        * Contractions are performed until a fixed point has been obtained on the whole graph,
        * or if the computation time limit has been reached.
        *
-       * Note that the computation time may slightly exceed \f$dt\f$.
+       * Note that the computation time may slightly exceed \f$dt\f$, since a contractor
+       * that has been started is not interrupted.
        *
-       * \param dt allowed computation time
+       * \param dt allowed computation time (wall-clock)
        * \param verbose verbose mode, `false` by default
        * \return the computation time in seconds
        */
       double contract_during(double dt, bool verbose = false);
 
+      /**
+       * \brief Saves the values of all the domains of the graph,
+       *        and the contractors currently waiting for process
+       *
+       * The graph (domains, contractors) is not copied: the checkpoint can only be
+       * restored in this network. Domains added after the checkpoint are not restored.
+       * The values are compared with the ones of the previous checkpoint (or of the
+       * last restored one): the unchanged blocks of values are shared, not copied.
+       *
+       * \return the CNCheckpoint object, that can be copied at low cost
+       */
+      const CNCheckpoint checkpoint() const;
+
+      /**
+       * \brief Restores the values of the domains and the queue of contractors
+       *        that have been saved by checkpoint()
+       *
+       * This allows exploratory contractions (for instance in a branch-and-prune search)
+       * without rebuilding the graph.
+       *
+       * \param checkpoint snapshot previously taken from this network
+       */
+      void restore(const CNCheckpoint& checkpoint);
+
+      /**
+       * \brief Freezes the current graph into a static execution plan
+       *
+       * The plan calls the contractors in forward/backward sweeps, in an order
+       * given by a breadth-first traversal of the graph. It is intended for
+       * repeated solves of the same network with new values of the domains.
+       * The queue of this network is not involved in the runs of the plan.
+       *
+       * \note All the CN variables have to be associated to domains
+       *
+       * \return the CNExecutionPlan object
+       */
+      CNExecutionPlan compile();
+
+      /**
+       * \brief Sets the limits of the next propagation processes
+       *
+       * The wall-clock time limit is measured with a steady clock. The limit on the
+       * number of contractions of each domain bounds the number of times a domain
+       * triggers its related contractors: once reached, the next contractions of this
+       * domain are not propagated anymore. The cancellation token can be triggered from
+       * another thread for stopping the propagation as soon as the running contractors
+       * return.
+       *
+       * \note The limits are not transmitted to the sub-networks
+       *
+       * \param budget limits of the propagation, no limit by default
+       */
+      void set_budget(const ContractionBudget& budget);
+
+      /**
+       * \brief Returns the limits of the propagation processes
+       *
+       * \return the ContractionBudget object
+       */
+      const ContractionBudget& budget() const;
+
+      /**
+       * \brief Returns the reason why the last propagation process stopped
+       *
+       * \return the ContractionStatus of the last call to contract()
+       */
+      ContractionStatus status() const;
+
+      /**
+       * \brief Returns the number of contractor calls performed by the last propagation process
+       *
+       * \return number of calls
+       */
+      int nb_ctc_calls() const;
+
       /**
        * \brief Sets the fixed point ratio defining the end of the propagation process.
        *
@@ -289,6 +372,103 @@ namespace codac
        */
       void set_fixedpoint_ratio(float r);
 
+      /**
+       * \brief Sets the number of threads used by the propagation process.
+       *
+       * With \f$n>1\f$, the contractors of the queue are dispatched among \f$n\f$ threads.
+       * A contractor is started only if it does not share any domain (or any non-reentrant
+       * object such as an IBEX contractor) with the ones currently running, so that domains
+       * are never accessed concurrently. The contractors are not called in the same order as
+       * in the sequential mode, but the propagation stops on the same fixed point (up to the
+       * fixed point ratio).
+       *
+       * \note Several nodes sharing the same contractor object (for instance a same CtcFunction
+       *       applied on each slice of a tube) are not run simultaneously, except for the
+       *       stateless CtcEval, CtcDeriv and CtcDist.
+       *
+       * \param nb_threads number of threads, \f$n=1\f$ (sequential mode) by default,
+       *        \f$n=0\f$ for the number of concurrent threads supported by the hardware
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Returns the number of threads used by the propagation process.
+       *
+       * \return number of threads
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Sets the policy defining the order in which the active contractors
+       *        are applied during the propagation.
+       *
+       * By default (`nullptr`), the contractors related to the last contracted domains
+       * are called first, which amounts to a depth-first propagation. Built-in policies
+       * are CheapestFirstScheduler, LargestRatioFirstScheduler and RoundRobinScheduler.
+       * The contractors currently waiting for process are moved to the new queue.
+       *
+       * \note The scheduler is not owned by the ContractorNetwork and must outlive it
+       *       (or be unset before being destroyed). It is not compatible with
+       *       contract_ordered_mode().
+       *
+       * \param scheduler pointer to the ContractorScheduler, or `nullptr` for the default behaviour
+       */
+      void set_scheduler(ContractorScheduler *scheduler);
+
+      /**
+       * \brief Returns the policy used to order the active contractors
+       *
+       * \return pointer to the ContractorScheduler, `nullptr` for the default behaviour
+       */
+      ContractorScheduler* scheduler() const;
+
+      /**
+       * \brief Enables or disables the profiling of the contractors.
+       *
+       * When enabled, the number of calls, the cumulated computation time and the
+       * volume removed from the domains are recorded for each contractor of the graph.
+       *
+       * \note The profiling slows down the propagation, since the volumes of the
+       *       domains are computed before and after each contraction.
+       *
+       * \param enabled `true` for enabling the profiling (default is `false`)
+       */
+      void set_profiling(bool enabled);
+
+      /**
+       * \brief Returns `true` if the contractors are profiled during the propagation
+       *
+       * \return profiling status
+       */
+      bool profiling() const;
+
+      /**
+       * \brief Resets the statistics recorded by the profiling
+       */
+      void reset_profiling();
+
+      /**
+       * \brief Returns the statistics recorded for each contractor of the graph
+       *        since the profiling has been enabled
+       *
+       * \return vector of ContractorProfile, sorted by decreasing computation time
+       */
+      const std::vector<ContractorProfile> profiling_report() const;
+
+      /**
+       * \brief Exports the profiling report in a CSV file, one line per contractor
+       *
+       * \param file_path path of the file to be written
+       */
+      void export_profiling_csv(const std::string& file_path) const;
+
+      /**
+       * \brief Exports the profiling report in a JSON file
+       *
+       * \param file_path path of the file to be written
+       */
+      void export_profiling_json(const std::string& file_path) const;
+
       /**
        * \brief Triggers on all contractors involved in the graph.
        *
@@ -353,9 +533,12 @@ namespace codac
        *        * sfdp - multiscale version of fdp for the layout of large graphs
        *        * twopi - radial layouts, nodes are placed on concentric circles depending their distance from a given root node
        *        * circo - circular layout, suitable for certain diagrams of multiple cyclic structures
+       * \param show_profiling if `true`, contractors nodes are annotated with their number
+       *        of calls and computation time, and colored according to their share of the total
+       *        computation time (see set_profiling())
        * \return system command success
        */
-      int print_dot_graph(const std::string& cn_name = "cn", const std::string& layer_model = "fdp") const;
+      int print_dot_graph(const std::string& cn_name = "cn", const std::string& layer_model = "fdp", bool show_profiling = false) const;
 
       /**
        * \brief Displays a synthesis of this ContractorNetwork
@@ -402,8 +585,60 @@ namespace codac
        */
       void add_ctc_to_queue(Contractor *ac, std::deque<Contractor*>& ctc_deque);
 
+      /**
+       * \brief Adds a Contractor object in the queue of active contractors of the network,
+       *        according to the current scheduling policy
+       *
+       * \param ac Contractor to be added
+       */
+      void push_active_ctc(Contractor *ac);
+
+      /**
+       * \brief Removes the next Contractor to be applied from the queue of the network
+       *
+       * \return pointer to the Contractor
+       */
+      Contractor* pop_active_ctc();
+
+      /**
+       * \brief Returns `true` if no contractor of the network is waiting for process
+       *
+       * \return emptiness test
+       */
+      bool no_active_ctc() const;
+
+      /**
+       * \brief Applies a Contractor and, if a scheduler is set, measures the computation
+       *        time and the impact of the contraction to be reported to it.
+       *        The measures are also recorded in the Contractor when profiling.
+       *
+       * \note Component contractors are not reported to the scheduler: their cost
+       *       only depends on the domains that have changed
+       *
+       * \param ctc pointer to the Contractor
+       * \param duration computation time in seconds (output)
+       * \param ratio ratio of the volumes of the domains after/before the contraction (output)
+       * \return `true` if the measures have to be reported to the scheduler
+       */
+      bool apply_ctc(Contractor *ctc, double& duration, double& ratio) const;
+
       void reset_value(Domain *dom);
 
+      /**
+       * \brief Checks the limits of the current propagation, and updates the status accordingly
+       *
+       * \param t_end wall-clock deadline of the propagation
+       * \return `true` if the propagation has to be stopped
+       */
+      bool budget_exhausted(const std::chrono::steady_clock::time_point& t_end);
+
+      /**
+       * \brief Builds the compact adjacency of the graph (domains to contractors,
+       *        vectors to components) used during the propagation, if the graph
+       *        has changed since the last build
+       */
+      void build_adjacency();
+
       /**
        * \brief Triggers on the contractors related to the given Domain
        *
@@ -412,23 +647,96 @@ namespace codac
        */
       void trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = nullptr);
 
-      void replace_var_by_dom(Domain var, Domain dom);
+      /**
+       * \brief Triggers on the contractors related to the domains of a Contractor
+       *        that has just been applied
+       *
+       * \note For the component contractor linking a Tube to its slices, only the slices
+       *       related to the last changes of the tube (see Tube::changed_tdomain()) are
+       *       considered, which avoids a whole sweep of the tube for local contractions.
+       *
+       * \param ctc pointer to the Contractor
+       */
+      void trigger_ctc_related_to_ctc_doms(Contractor *ctc);
+
+      /**
+       * \brief Makes a variable of the graph point to an actual domain
+       *
+       * \param var the variable
+       * \param dom the domain, or the variable itself for releasing the reference
+       * \param trigger if `false`, the related contractors are not triggered, but they
+       *        will be at the next binding of the variable
+       */
+      void replace_var_by_dom(Domain var, Domain dom, bool trigger = true);
+
+      /**
+       * \brief Appends to `v_keys` the memory locations that may be accessed
+       *        when contracting the given Domain
+       *
+       * \param dom pointer to the Domain
+       * \param v_keys list of memory keys to be completed
+       */
+      static void add_footprint(const Domain *dom, std::vector<uintptr_t>& v_keys);
+
+      /**
+       * \brief Appends to `v_keys` the memory locations of a Tube and its slices
+       *
+       * \param x the Tube
+       * \param v_keys list of memory keys to be completed
+       */
+      static void add_footprint(const Tube& x, std::vector<uintptr_t>& v_keys);
+
+      /**
+       * \brief Computes the memory locations that may be accessed by a Contractor.
+       *        Two contractors can be run simultaneously if their footprints are disjoint.
+       *
+       * \param ctc pointer to the Contractor
+       * \param v_keys sorted list of memory keys
+       * \return `false` if the Contractor requires an exclusive access to the network
+       */
+      static bool ctc_footprint(Contractor *ctc, std::vector<uintptr_t>& v_keys);
+
+      /**
+       * \brief Propagates the contractions of the queue over several threads,
+       *        until a fixed point is reached or the budget is exhausted
+       *
+       * \param t_end wall-clock deadline of the propagation
+       */
+      void propagate_parallel(const std::chrono::steady_clock::time_point& t_end);
 
     protected:
 
-      std::map<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
-      std::map<ContractorHashcode,Contractor*> m_map_ctc; //!< pointers to the abstract Contractor objects the graph is made of
+      std::vector<Domain*> m_v_domains; //!< pointers to the abstract Domain objects the graph is made of, indexed by their dense id
+      std::vector<Contractor*> m_v_ctc; //!< pointers to the abstract Contractor objects the graph is made of, indexed by their dense id
+      std::unordered_map<DomainHashcode,Domain*> m_map_domains; //!< hash index of the domains, for fast lookups when building the graph
+      std::unordered_map<ContractorHashcode,Contractor*> m_map_ctc; //!< hash index of the contractors, for fast lookups when building the graph
+
+      // Compact adjacency (CSR format), built from the graph before the propagation
+      std::vector<int> m_adj_ctc_offsets; //!< for each domain id, range of its contractors in m_adj_ctc
+      std::vector<Contractor*> m_adj_ctc; //!< contractors related to each domain, stored contiguously
+      std::vector<int> m_adj_comp_offsets; //!< for each domain id, range of its components in m_adj_comp
+      std::vector<Domain*> m_adj_comp; //!< components of each IntervalVector domain, stored contiguously
+      bool m_adjacency_valid = false; //!< false if the graph has changed since the last build of the adjacency
       std::deque<Contractor*> m_deque; //!< queue of active contractors
+      std::vector<Domain*> m_v_new_domains; //!< domains added since the last contraction, for which the volume is not known yet
 
       int m_iteration_nb = 0;
       float m_fixedpoint_ratio = 0.0001; //!< fixed point ratio for propagation limit
-      double m_contraction_duration_max = std::numeric_limits<double>::infinity(); //!< computation time limit
+      ContractionBudget m_budget; //!< limits of the propagation processes
+      ContractionStatus m_status = ContractionStatus::FIXED_POINT; //!< reason why the last propagation stopped
+      int m_nb_ctc_calls = 0; //!< number of contractor calls of the last propagation
+      std::vector<int> m_v_dom_contractions; //!< number of propagated contractions of each domain, during the last propagation
+      int m_nb_threads = 1; //!< number of threads used for the propagation
+      ContractorScheduler *m_scheduler = nullptr; //!< optional policy for ordering the active contractors (not owned)
+      bool m_profiling = false; //!< if true, statistics are recorded for each contractor
+      mutable std::weak_ptr<const CNCheckpoint::Data> m_last_checkpoint; //!< last taken or restored snapshot, for sharing its unchanged values
 
       CtcDeriv *m_ctc_deriv = nullptr; //!< optional pointer to a CtcDeriv object that can be automatically added in the graph
       std::list<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv;
 
       friend class Domain;
       friend class Contractor;
+      friend class CNSolver;
   };
 }
 
@@ -0,0 +1,235 @@
+/**
+ *  ContractorNetwork class : checkpoints
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <unordered_set>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    const CNCheckpoint ContractorNetwork::checkpoint() const
+    {
+      shared_ptr<CNCheckpoint::Data> data = make_shared<CNCheckpoint::Data>();
+      data->cn = this;
+
+      // Blocks of the previous snapshot (if still alive), indexed by domain:
+      // the unchanged blocks are shared instead of being copied
+      shared_ptr<const CNCheckpoint::Data> prev = m_last_checkpoint.lock();
+      vector<int> v_prev_first_block(m_v_domains.size(), -1);
+      if(prev)
+        for(const auto& entry : prev->v_domains)
+          if(entry.first < (int)v_prev_first_block.size())
+            v_prev_first_block[entry.first] = entry.second;
+
+      vector<Interval> block;
+      block.reserve(CNCheckpoint::BLOCK_SIZE);
+      int prev_block = -1; // block of the previous snapshot at the same place, if any
+
+      auto end_block = [&]()
+      {
+        if(prev_block >= 0 && prev_block < (int)prev->v_blocks.size() && *prev->v_blocks[prev_block] == block)
+          data->v_blocks.push_back(prev->v_blocks[prev_block]);
+
+        else
+        {
+          data->v_blocks.push_back(make_shared<const vector<Interval> >(block));
+          data->nb_new_values += block.size();
+        }
+
+        block.clear();
+        if(prev_block >= 0)
+          prev_block++;
+      };
+
+      auto push_value = [&](const Interval& x)
+      {
+        block.push_back(x);
+        if((int)block.size() == CNCheckpoint::BLOCK_SIZE)
+          end_block();
+      };
+
+      // Slices of a tube of the graph are saved with their tube
+      unordered_set<const Slice*> saved_slices;
+      for(const auto& dom : m_v_domains)
+        if(dom->type() == Domain::Type::T_TUBE)
+          for(const Slice *s = dom->tube().first_slice() ; s ; s = s->next_slice())
+            saved_slices.insert(s);
+
+      for(const auto& dom : m_v_domains)
+      {
+        if(dom->type() == Domain::Type::T_TUBE_VECTOR // saved through the tubes it is made of
+          || (dom->type() == Domain::Type::T_SLICE && saved_slices.find(&dom->slice()) != saved_slices.end()))
+          continue;
+
+        data->v_domains.push_back(make_pair(dom->m_cn_id, (int)data->v_blocks.size()));
+        prev_block = v_prev_first_block[dom->m_cn_id];
+
+        switch(dom->type())
+        {
+          case Domain::Type::T_INTERVAL:
+            push_value(dom->interval());
+            break;
+
+          case Domain::Type::T_INTERVAL_VECTOR:
+            for(int i = 0 ; i < dom->interval_vector().size() ; i++)
+              push_value(dom->interval_vector()[i]);
+            break;
+
+          case Domain::Type::T_SLICE:
+            push_value(dom->slice().codomain());
+            push_value(dom->slice().input_gate());
+            push_value(dom->slice().output_gate());
+            break;
+
+          case Domain::Type::T_TUBE:
+          {
+            // Envelope and input gate of each slice, then the last output gate
+            for(const Slice *s = dom->tube().first_slice() ; s ; s = s->next_slice())
+            {
+              push_value(s->codomain());
+              push_value(s->input_gate());
+            }
+            push_value(dom->tube().last_slice()->output_gate());
+            break;
+          }
+
+          default:
+            assert(false && "unhandled case");
+        }
+
+        if(!block.empty())
+          end_block();
+      }
+
+      // Contractors waiting for process
+      if(m_scheduler)
+      {
+        // The order will be defined by the scheduler
+        for(const auto& ctc : m_v_ctc)
+          if(ctc->is_active())
+            data->v_active_ctc.push_back(ctc->m_cn_id);
+      }
+
+      else
+        for(const auto& ctc : m_deque)
+          data->v_active_ctc.push_back(ctc->m_cn_id);
+
+      m_last_checkpoint = data;
+      CNCheckpoint checkpoint;
+      checkpoint.m_data = data;
+      return checkpoint;
+    }
+
+    void ContractorNetwork::restore(const CNCheckpoint& checkpoint)
+    {
+      if(checkpoint.is_empty())
+        throw Exception(__func__, "empty checkpoint");
+
+      const CNCheckpoint::Data& data = *checkpoint.m_data;
+      if(data.cn != this)
+        throw Exception(__func__, "checkpoint taken from another contractor network");
+
+      for(size_t i = 0 ; i < data.v_domains.size() ; i++)
+      {
+        Domain *dom = m_v_domains[data.v_domains[i].first];
+        const int first_block = data.v_domains[i].second;
+        const int end_block = i+1 < data.v_domains.size() ? data.v_domains[i+1].second : (int)data.v_blocks.size();
+
+        int nb_values = 0;
+        for(int b = first_block ; b < end_block ; b++)
+          nb_values += data.v_blocks[b]->size();
+
+        // Values of the domain, read block after block
+        int b = first_block, j = 0;
+        auto value = [&]() -> const Interval&
+        {
+          if(j == (int)data.v_blocks[b]->size())
+          {
+            b++;
+            j = 0;
+          }
+          return (*data.v_blocks[b])[j++];
+        };
+
+        switch(dom->type())
+        {
+          case Domain::Type::T_INTERVAL:
+            dom->interval() = value();
+            break;
+
+          case Domain::Type::T_INTERVAL_VECTOR:
+            assert(nb_values == dom->interval_vector().size());
+            for(int k = 0 ; k < nb_values ; k++)
+              dom->interval_vector()[k] = value();
+            break;
+
+          case Domain::Type::T_SLICE:
+            assert(nb_values == 3);
+            dom->slice().set_envelope(value(), false);
+            dom->slice().set_input_gate(value(), false);
+            dom->slice().set_output_gate(value(), false);
+            break;
+
+          case Domain::Type::T_TUBE:
+          {
+            Tube& x = dom->tube();
+            if(nb_values != 2*x.nb_slices()+1)
+              throw Exception(__func__, "the slicing of a tube has changed since the checkpoint");
+
+            for(Slice *s = x.first_slice() ; s ; s = s->next_slice())
+            {
+              s->set_envelope(value(), false);
+              s->set_input_gate(value(), false);
+            }
+            x.last_slice()->set_output_gate(value(), false);
+
+            // Restored values are not considered as new changes of the tube
+            // for this network (other consumers will consider the whole tube)
+            dom->m_changes_window_id = x.reset_changed_tdomain();
+            break;
+          }
+
+          default:
+            assert(false && "unhandled case");
+        }
+      }
+
+      // Volumes (for fixed point detection) of all the domains, including slices and vectors
+      for(const auto& dom : m_v_domains)
+        dom->set_volume(dom->compute_volume());
+
+      // Next checkpoints will share the unchanged values of this one
+      m_last_checkpoint = checkpoint.m_data;
+
+      // Restoring the queue of contractors
+      m_deque.clear();
+      if(m_scheduler)
+        m_scheduler->clear();
+
+      for(const auto& ctc : m_v_ctc)
+        if(ctc->type() != Contractor::Type::T_CN)
+          ctc->m_active = false;
+
+      for(const auto& id : data.v_active_ctc)
+      {
+        Contractor *ctc = m_v_ctc[id];
+        ctc->m_active = true;
+        if(m_scheduler)
+          m_scheduler->push(ctc);
+        else
+          m_deque.push_back(ctc);
+      }
+    }
+}
@@ -0,0 +1,314 @@
+/**
+ *  ContractorNetwork class : parallel propagation
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include <unordered_set>
+#include <condition_variable>
+#include "codac_ContractorNetwork.h"
+#include "codac_CtcEval.h"
+#include "codac_CtcDeriv.h"
+#include "codac_CtcDist.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    void ContractorNetwork::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0 && "invalid number of threads");
+
+      if(nb_threads == 0)
+        nb_threads = std::max(1, (int)thread::hardware_concurrency());
+      m_nb_threads = nb_threads;
+
+      for(const auto& ctc : m_v_ctc)
+        if(ctc->type() == Contractor::Type::T_CN)
+          ctc->cn_ctc().set_nb_threads(nb_threads);
+    }
+
+    int ContractorNetwork::nb_threads() const
+    {
+      return m_nb_threads;
+    }
+
+  // Protected methods
+
+    void ContractorNetwork::add_footprint(const Domain *dom, vector<uintptr_t>& v_keys)
+    {
+      switch(dom->type())
+      {
+        case Domain::Type::T_INTERVAL:
+          v_keys.push_back((uintptr_t)&dom->interval());
+          break;
+
+        case Domain::Type::T_INTERVAL_VECTOR:
+          v_keys.push_back((uintptr_t)&dom->interval_vector());
+          for(int i = 0 ; i < dom->interval_vector().size() ; i++)
+            v_keys.push_back((uintptr_t)&dom->interval_vector()[i]);
+          break;
+
+        case Domain::Type::T_SLICE:
+        {
+          // Gates are shared with the neighbours, and some setters
+          // read the envelope of adjacent slices
+          const Slice& s = dom->slice();
+          v_keys.push_back((uintptr_t)&s);
+          if(s.prev_slice())
+            v_keys.push_back((uintptr_t)s.prev_slice());
+          if(s.next_slice())
+            v_keys.push_back((uintptr_t)s.next_slice());
+
+          // The optional synthesis tree is shared by all the slices of the tube
+          if(s.m_synthesis_reference)
+            v_keys.push_back((uintptr_t)s.m_synthesis_reference->root());
+          break;
+        }
+
+        case Domain::Type::T_TUBE:
+          add_footprint(dom->tube(), v_keys);
+          break;
+
+        case Domain::Type::T_TUBE_VECTOR:
+          v_keys.push_back((uintptr_t)&dom->tube_vector());
+          for(int i = 0 ; i < dom->tube_vector().size() ; i++)
+            add_footprint(dom->tube_vector()[i], v_keys);
+          break;
+
+        default:
+          assert(false && "unhandled case");
+      }
+    }
+
+    void ContractorNetwork::add_footprint(const Tube& x, vector<uintptr_t>& v_keys)
+    {
+      v_keys.push_back((uintptr_t)&x);
+      for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+        v_keys.push_back((uintptr_t)s);
+      if(x.first_slice()->m_synthesis_reference)
+        v_keys.push_back((uintptr_t)x.first_slice()->m_synthesis_reference->root());
+    }
+
+    bool ContractorNetwork::ctc_footprint(Contractor *ctc, vector<uintptr_t>& v_keys)
+    {
+      v_keys.clear();
+
+      switch(ctc->type())
+      {
+        case Contractor::Type::T_CN:
+          // Sub-networks are run alone
+          return false;
+
+        case Contractor::Type::T_IBEX:
+          // IBEX contractors (and their functions) are not reentrant
+          v_keys.push_back((uintptr_t)&ctc->ibex_ctc());
+          break;
+
+        case Contractor::Type::T_CODAC:
+        {
+          // Same for Codac contractors, except the stateless ones that
+          // can be shared among several nodes of the graph
+          const DynCtc& dyn_ctc = ctc->codac_ctc();
+          if(typeid(dyn_ctc) != typeid(CtcEval)
+            && typeid(dyn_ctc) != typeid(CtcDeriv)
+            && typeid(dyn_ctc) != typeid(CtcDist))
+            v_keys.push_back((uintptr_t)&dyn_ctc);
+          break;
+        }
+
+        default:
+          break;
+      }
+
+      for(const auto& dom : ctc->domains())
+        add_footprint(dom, v_keys);
+
+      sort(v_keys.begin(), v_keys.end());
+      v_keys.erase(unique(v_keys.begin(), v_keys.end()), v_keys.end());
+      return true;
+    }
+
+    void ContractorNetwork::propagate_parallel(const chrono::steady_clock::time_point& t_end)
+    {
+      assert(m_nb_threads > 1);
+
+      // Footprints are computed once for this propagation. A contractor
+      // without footprint (sub-network) requires an exclusive access.
+      struct Footprint
+      {
+        bool shared;
+        vector<uintptr_t> keys;
+      };
+
+      unordered_map<const Contractor*,Footprint> map_footprints;
+      for(const auto& ctc : m_v_ctc)
+      {
+        Footprint& fp = map_footprints[ctc];
+        fp.shared = ctc_footprint(ctc, fp.keys);
+      }
+
+      // The tracked volumes of the tubes are computed before the workers start,
+      // so that the slices are already in charge of reporting their changes
+      for(const auto& dom : m_v_domains)
+        if(dom->type() == Domain::Type::T_TUBE || dom->type() == Domain::Type::T_TUBE_VECTOR)
+          dom->compute_volume();
+
+      mutex mtx;
+      condition_variable cv;
+      unordered_set<uintptr_t> locked_keys;
+      int nb_running = 0;
+      bool exclusive_running = false;
+      bool stop = false;
+      exception_ptr error = nullptr;
+
+      // Returns true if the contractor does not share any domain with the running ones
+      auto can_run = [&](const Contractor *ctc) -> bool
+      {
+        const Footprint& fp = map_footprints[ctc];
+
+        if(!fp.shared)
+          return nb_running == 0;
+
+        for(const auto& k : fp.keys)
+          if(locked_keys.find(k) != locked_keys.end())
+            return false;
+        return true;
+      };
+
+      // Removes from the queue the first contractor (by priority) that can be run,
+      // or returns nullptr if none
+      auto pick_ctc = [&]() -> Contractor*
+      {
+        if(exclusive_running)
+          return nullptr;
+
+        if(!m_scheduler)
+        {
+          for(auto it = m_deque.begin() ; it != m_deque.end() ; ++it)
+            if(can_run(*it))
+            {
+              Contractor *ctc = *it;
+              m_deque.erase(it);
+              return ctc;
+            }
+
+          return nullptr;
+        }
+
+        // With a scheduling policy, contractors that cannot be run
+        // for the moment are put back in the queue
+        Contractor *picked = nullptr;
+        vector<Contractor*> v_postponed;
+        while(!picked && !m_scheduler->empty())
+        {
+          Contractor *ctc = m_scheduler->pop();
+          if(can_run(ctc))
+            picked = ctc;
+          else
+            v_postponed.push_back(ctc);
+        }
+
+        for(auto& ctc : v_postponed)
+          m_scheduler->push(ctc);
+        return picked;
+      };
+
+      auto worker = [&]()
+      {
+        unique_lock<mutex> lock(mtx);
+
+        while(!stop)
+        {
+          // The fixed point is tested first: reaching the budget
+          // at the same time is not a partial propagation
+          if((no_active_ctc() && nb_running == 0) || budget_exhausted(t_end))
+          {
+            stop = true;
+            cv.notify_all();
+            break;
+          }
+
+          Contractor *ctc = pick_ctc();
+
+          if(!ctc)
+          {
+            // Some contractors are running (otherwise any queued one could be
+            // picked): the end of each of them notifies the waiting workers,
+            // and the budget is then checked again
+            cv.wait(lock);
+            continue;
+          }
+
+          const Footprint& fp = map_footprints[ctc];
+
+          for(const auto& k : fp.keys)
+            locked_keys.insert(k);
+          exclusive_running = !fp.shared;
+          nb_running++;
+          m_nb_ctc_calls++;
+
+          lock.unlock();
+
+            bool success = true, measured = false;
+            double duration, ratio;
+            try
+            {
+              measured = apply_ctc(ctc, duration, ratio);
+            }
+
+            catch(...)
+            {
+              success = false;
+              lock.lock();
+              if(!error)
+                error = current_exception();
+              stop = true;
+              lock.unlock();
+            }
+
+          lock.lock();
+
+          if(success)
+          {
+            if(measured)
+              m_scheduler->update(ctc, duration, ratio);
+
+            if(ctc->type() != Contractor::Type::T_CN)
+              ctc->set_active(false); // Sub CN will be always triggered
+
+            trigger_ctc_related_to_ctc_doms(ctc);
+          }
+
+          for(const auto& k : fp.keys)
+            locked_keys.erase(k);
+          exclusive_running = false;
+          nb_running--;
+          cv.notify_all();
+        }
+      };
+
+      vector<thread> v_threads;
+      for(int i = 1 ; i < m_nb_threads ; i++)
+        v_threads.push_back(thread(worker));
+      worker(); // the calling thread takes part in the propagation
+
+      for(auto& t : v_threads)
+        t.join();
+
+      if(error)
+        rethrow_exception(error);
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ *  ContractorNetwork class : static execution plan
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <deque>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    CNExecutionPlan ContractorNetwork::compile()
+    {
+      for(const auto& dom : m_v_domains)
+        if(dom->is_var_not_associated())
+          throw Exception(__func__, "some CN variables are not associated to domains");
+
+      build_adjacency();
+
+      CNExecutionPlan plan;
+      plan.m_cn = this;
+      plan.m_cn_nb_ctc = m_v_ctc.size();
+      plan.m_cn_nb_dom = m_v_domains.size();
+      plan.m_fixedpoint_ratio = m_fixedpoint_ratio;
+
+      vector<bool> visited_ctc(m_v_ctc.size(), false), visited_dom(m_v_domains.size(), false);
+      deque<Contractor*> bfs;
+
+      // Breadth-first traversal of the graph, from the first added contractors:
+      // each contractor is called after the ones it shares domains with
+
+      for(const auto& root : m_v_ctc)
+      {
+        if(visited_ctc[root->m_cn_id])
+          continue;
+
+        visited_ctc[root->m_cn_id] = true;
+        bfs.push_back(root);
+
+        while(!bfs.empty())
+        {
+          Contractor *ctc = bfs.front();
+          bfs.pop_front();
+
+          if(ctc->type() != Contractor::Type::T_COMPONENT) // symbolic contractors are not called
+          {
+            plan.m_v_ctc.push_back(ctc);
+
+            if(ctc->type() == Contractor::Type::T_IBEX && !(ctc->m_v_domains.size() == 1
+              && ctc->m_v_domains[0]->type() == Domain::Type::T_INTERVAL_VECTOR))
+            {
+              plan.m_v_box_id.push_back(plan.m_v_boxes.size());
+              plan.m_v_boxes.push_back(IntervalVector(ctc->ibex_ctc().nb_var));
+            }
+
+            else
+              plan.m_v_box_id.push_back(-1);
+          }
+
+          for(const auto& dom : ctc->m_v_domains)
+          {
+            const int id = dom->m_cn_id;
+            if(visited_dom[id])
+              continue;
+
+            visited_dom[id] = true;
+            for(int k = m_adj_ctc_offsets[id] ; k < m_adj_ctc_offsets[id+1] ; k++)
+              if(!visited_ctc[m_adj_ctc[k]->m_cn_id])
+              {
+                visited_ctc[m_adj_ctc[k]->m_cn_id] = true;
+                bfs.push_back(m_adj_ctc[k]);
+              }
+          }
+        }
+      }
+
+      // Domains involved in the called contractors, for the fixed point detection
+      vector<bool> monitored_dom(m_v_domains.size(), false);
+      for(const auto& ctc : plan.m_v_ctc)
+        for(const auto& dom : ctc->m_v_domains)
+          if(!monitored_dom[dom->m_cn_id])
+          {
+            monitored_dom[dom->m_cn_id] = true;
+            plan.m_v_domains.push_back(dom);
+          }
+
+      plan.m_v_volumes.assign(plan.m_v_domains.size(), 0.);
+      return plan;
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ *  ContractorNetwork class : profiling
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    void ContractorNetwork::set_profiling(bool enabled)
+    {
+      m_profiling = enabled;
+
+      for(const auto& ctc : m_v_ctc)
+        if(ctc->type() == Contractor::Type::T_CN)
+          ctc->cn_ctc().set_profiling(enabled);
+    }
+
+    bool ContractorNetwork::profiling() const
+    {
+      return m_profiling;
+    }
+
+    void ContractorNetwork::reset_profiling()
+    {
+      for(const auto& ctc : m_v_ctc)
+      {
+        ctc->reset_profile();
+        if(ctc->type() == Contractor::Type::T_CN)
+          ctc->cn_ctc().reset_profiling();
+      }
+    }
+
+    const vector<ContractorProfile> ContractorNetwork::profiling_report() const
+    {
+      vector<ContractorProfile> v_profiles;
+      for(const auto& ctc : m_v_ctc)
+        v_profiles.push_back(ctc->profile());
+
+      stable_sort(v_profiles.begin(), v_profiles.end(),
+        [](const ContractorProfile& a, const ContractorProfile& b) { return a.time > b.time; });
+      return v_profiles;
+    }
+
+    void ContractorNetwork::export_profiling_csv(const string& file_path) const
+    {
+      ofstream file(file_path);
+      if(!file.is_open())
+        throw Exception(__func__, "unable to create file " + file_path);
+
+      file << setprecision(numeric_limits<double>::max_digits10);
+      file << "id,name,nb_calls,nb_contractions,time,volume_reduction" << endl;
+
+      for(const auto& p : profiling_report())
+      {
+        // Names are quoted, with doubled quotes
+        string name;
+        for(const auto& c : p.name)
+          name += (c == '"') ? string("\"\"") : string(1, c);
+
+        file << p.ctc_id << ",\"" << name << "\"," << p.nb_calls << "," << p.nb_contractions
+             << "," << p.time << "," << p.volume_reduction << endl;
+      }
+    }
+
+    void ContractorNetwork::export_profiling_json(const string& file_path) const
+    {
+      ofstream file(file_path);
+      if(!file.is_open())
+        throw Exception(__func__, "unable to create file " + file_path);
+
+      file << setprecision(numeric_limits<double>::max_digits10);
+      file << "[" << endl;
+
+      const vector<ContractorProfile> v_profiles = profiling_report();
+      for(size_t i = 0 ; i < v_profiles.size() ; i++)
+      {
+        const ContractorProfile& p = v_profiles[i];
+
+        // Escaping names (that may contain LaTeX code)
+        string name;
+        for(const auto& c : p.name)
+        {
+          if(c == '"' || c == '\\')
+            name += '\\';
+          name += c;
+        }
+
+        file << "  { \"id\": " << p.ctc_id
+             << ", \"name\": \"" << name << "\""
+             << ", \"nb_calls\": " << p.nb_calls
+             << ", \"nb_contractions\": " << p.nb_contractions
+             << ", \"time\": " << p.time
+             << ", \"volume_reduction\": " << p.volume_reduction
+             << " }" << (i+1 < v_profiles.size() ? "," : "") << endl;
+      }
+
+      file << "]" << endl;
+    }
+}
@@ -8,7 +8,8 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
+#include <chrono>
+#include <algorithm>
 #include "codac_ContractorNetwork.h"
 #include "codac_Exception.h"
 
@@ -25,55 +26,75 @@ namespace codac
     {
       // Checking existance of remaining variables
       // All of them should be associated to domains
-      for(const auto& dom : m_map_domains)
+      for(const auto& dom : m_v_domains)
       {
-        if(dom.second->is_var_not_associated())
+        if(dom->is_var_not_associated())
           throw Exception(__func__, "some CN variables are not associated to domains");
       }
 
-      clock_t t_start = clock();
-      for(auto& dom : m_map_domains)
-        dom.second->set_volume(dom.second->compute_volume());
+      typedef chrono::steady_clock clock_type;
+      const clock_type::time_point t_start = clock_type::now();
+      const clock_type::time_point t_end = std::isinf(m_budget.max_duration)
+        ? clock_type::time_point::max()
+        : t_start + chrono::duration_cast<clock_type::duration>(chrono::duration<double>(m_budget.max_duration));
+
+      build_adjacency();
+      m_status = ContractionStatus::FIXED_POINT;
+      m_nb_ctc_calls = 0;
+      if(m_budget.max_dom_contractions >= 0)
+        m_v_dom_contractions.assign(m_v_domains.size(), 0);
+
+      // Volumes of the other domains are kept up to date during the propagations
+      for(auto& dom : m_v_new_domains)
+        dom->set_volume(dom->compute_volume());
+      m_v_new_domains.clear();
 
       if(verbose)
       {
-        cout << "Contractor network has " << m_map_ctc.size()
-             << " contractors and " << m_map_domains.size() << " domains" << endl;
+        cout << "Contractor network has " << m_v_ctc.size()
+             << " contractors and " << m_v_domains.size() << " domains" << endl;
         cout << "Computing, " << nb_ctc_in_stack() << " contractors currently in stack";
-        if(!std::isinf(m_contraction_duration_max))
-          cout << " during " << m_contraction_duration_max << "s";
+        if(!std::isinf(m_budget.max_duration))
+          cout << " during " << m_budget.max_duration << "s";
         cout << endl;
       }
 
-      while(!m_deque.empty()
-        && (double)(clock() - t_start)/CLOCKS_PER_SEC < m_contraction_duration_max)
-      {
-        Contractor *ctc = m_deque.front();
-        m_deque.pop_front();
+      if(m_nb_threads > 1)
+        propagate_parallel(t_end);
 
-        ctc->contract();
-        if(ctc->type() != Contractor::Type::T_CN)
-          ctc->set_active(false); // Sub CN will be always triggered
-        
-        for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
-          // If the domain has "changed" after the contraction
-          trigger_ctc_related_to_dom(ctc_dom, ctc);
+      else
+      {
+        while(!no_active_ctc() && !budget_exhausted(t_end))
+        {
+          Contractor *ctc = pop_active_ctc();
+          m_nb_ctc_calls++;
+
+          double duration, ratio;
+          if(apply_ctc(ctc, duration, ratio))
+            m_scheduler->update(ctc, duration, ratio);
+          if(ctc->type() != Contractor::Type::T_CN)
+            ctc->set_active(false); // Sub CN will be always triggered
+          
+          trigger_ctc_related_to_ctc_doms(ctc);
+        }
       }
 
+      double propagation_time = chrono::duration<double>(clock_type::now() - t_start).count();
+
       if(verbose)
-        cout << "  Constraint propagation time: " << (double)(clock() - t_start)/CLOCKS_PER_SEC << "s" << endl;
+        cout << "  Constraint propagation time: " << propagation_time << "s" << endl;
 
       // Emptiness test
       // todo: test only contracted domains?
       if(verbose)
-        for(const auto& dom : m_map_domains)
-          if(dom.second->is_empty())
+        for(const auto& dom : m_v_domains)
+          if(dom->is_empty())
           {
             cout << "  Warning: empty set" << endl;
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return propagation_time;
     }
 
     double ContractorNetwork::contract(const unordered_map<Domain,Domain>& var_dom, bool verbose)
@@ -89,22 +110,27 @@ namespace codac
 
       double t = contract(verbose);
 
-      // Back to the "abstract" architecture with pure defined variables
+      // Back to the "abstract" architecture with pure defined variables,
+      // contractors will be triggered by the next binding
       for(auto& v : var_dom)
-        replace_var_by_dom(v.first, v.first); // points to itself
+        replace_var_by_dom(v.first, v.first, false); // points to itself
 
       return t;
     }
 
     double ContractorNetwork::contract_ordered_mode(bool verbose)
     {
+      if(m_scheduler)
+        throw Exception(__func__, "ordered mode is not compatible with a contractor scheduler");
+
       // todo: reset all saved domains' volumes
-      clock_t t_start = clock();
+      typedef chrono::steady_clock clock_type;
+      const clock_type::time_point t_start = clock_type::now();
 
       if(verbose)
       {
-        cout << "Contractor network has " << m_map_ctc.size()
-             << " contractors and " << m_map_domains.size() << " domains" << endl;
+        cout << "Contractor network has " << m_v_ctc.size()
+             << " contractors and " << m_v_domains.size() << " domains" << endl;
         cout << "Computing in ordered mode, " << nb_ctc_in_stack() << " contractors currently in stack";
         cout << endl;
       }
@@ -150,62 +176,109 @@ namespace codac
       // Emptiness test
       // todo: test only contracted domains?
       if(verbose)
-        for(const auto& dom : m_map_domains)
-          if(dom.second->is_empty())
+        for(const auto& dom : m_v_domains)
+          if(dom->is_empty())
           {
             cout << "  Warning: empty set" << endl;
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return chrono::duration<double>(clock_type::now() - t_start).count();
     }
 
     double ContractorNetwork::contract_during(double dt, bool verbose)
     {
-      double prev_dt = m_contraction_duration_max;
-      m_contraction_duration_max = dt;
+      double prev_dt = m_budget.max_duration;
+      m_budget.max_duration = dt;
       double contraction_time = contract(verbose);
-      m_contraction_duration_max = prev_dt;
+      m_budget.max_duration = prev_dt;
       return contraction_time;
     }
 
+    void ContractorNetwork::set_budget(const ContractionBudget& budget)
+    {
+      assert(budget.max_duration >= 0. && "invalid time limit");
+      assert(budget.max_ctc_calls >= -1 && budget.max_dom_contractions >= -1 && "invalid limit");
+      m_budget = budget;
+    }
+
+    const ContractionBudget& ContractorNetwork::budget() const
+    {
+      return m_budget;
+    }
+
+    ContractionStatus ContractorNetwork::status() const
+    {
+      return m_status;
+    }
+
+    int ContractorNetwork::nb_ctc_calls() const
+    {
+      return m_nb_ctc_calls;
+    }
+
     void ContractorNetwork::set_fixedpoint_ratio(float r)
     {
       assert(Interval(0.,1).contains(r) && "invalid ratio");
       m_fixedpoint_ratio = r;
 
-      for(const auto& ctc : m_map_ctc)
-        if(ctc.second->type() == Contractor::Type::T_CN)
-          ctc.second->cn_ctc().set_fixedpoint_ratio(r);
+      for(const auto& ctc : m_v_ctc)
+        if(ctc->type() == Contractor::Type::T_CN)
+          ctc->cn_ctc().set_fixedpoint_ratio(r);
+    }
+
+    void ContractorNetwork::set_scheduler(ContractorScheduler *scheduler)
+    {
+      // Pending contractors are transferred to the new queue
+      deque<Contractor*> pending;
+      while(!no_active_ctc())
+        pending.push_back(pop_active_ctc());
+
+      m_scheduler = scheduler;
+      if(m_scheduler)
+        m_scheduler->clear();
+
+      for(auto& ctc : pending)
+        if(m_scheduler)
+          m_scheduler->push(ctc);
+        else
+          m_deque.push_back(ctc);
+    }
+
+    ContractorScheduler* ContractorNetwork::scheduler() const
+    {
+      return m_scheduler;
     }
 
     void ContractorNetwork::trigger_all_contractors()
     {
       m_deque.clear();
+      if(m_scheduler)
+        m_scheduler->clear();
 
-      for(const auto& ctc : m_map_ctc)
+      for(const auto& ctc : m_v_ctc)
       {
-        if(ctc.second->type() == Contractor::Type::T_IBEX
-          || ctc.second->type() == Contractor::Type::T_CODAC
-          || ctc.second->type() == Contractor::Type::T_EQUALITY)
+        if(ctc->type() == Contractor::Type::T_IBEX
+          || ctc->type() == Contractor::Type::T_CODAC
+          || ctc->type() == Contractor::Type::T_EQUALITY)
         {
           // Only "contracting" contractors are triggered
-          ctc.second->set_active(true);
-          add_ctc_to_queue(ctc.second, m_deque);
+          ctc->set_active(true);
+          push_active_ctc(ctc);
         }
 
         else
-          ctc.second->set_active(false);
+          ctc->set_active(false);
       }
     }
 
     void ContractorNetwork::reset_interm_vars()
     {
-      for(auto& dom : m_map_domains)
-        if(dom.second->is_interm_var())
+      for(auto& dom : m_v_domains)
+        if(dom->is_interm_var())
         {
-          reset_value(dom.second);
-          trigger_ctc_related_to_dom(dom.second);
+          reset_value(dom);
+          trigger_ctc_related_to_dom(dom);
         }
 
       trigger_all_contractors();
@@ -214,7 +287,7 @@ namespace codac
 
     int ContractorNetwork::nb_ctc_in_stack() const
     {
-      return m_deque.size();
+      return m_scheduler ? m_scheduler->size() : m_deque.size();
     }
 
     int ContractorNetwork::iteration_nb() const
@@ -235,6 +308,67 @@ namespace codac
         ctc_deque.push_front(ac); // priority
     }
 
+    void ContractorNetwork::push_active_ctc(Contractor *ac)
+    {
+      if(m_scheduler)
+        m_scheduler->push(ac);
+      else
+        add_ctc_to_queue(ac, m_deque);
+    }
+
+    Contractor* ContractorNetwork::pop_active_ctc()
+    {
+      if(m_scheduler)
+        return m_scheduler->pop();
+
+      Contractor *ctc = m_deque.front();
+      m_deque.pop_front();
+      return ctc;
+    }
+
+    bool ContractorNetwork::no_active_ctc() const
+    {
+      return m_scheduler ? m_scheduler->empty() : m_deque.empty();
+    }
+
+    bool ContractorNetwork::apply_ctc(Contractor *ctc, double& duration, double& ratio) const
+    {
+      const bool feedback = m_scheduler && ctc->type() != Contractor::Type::T_COMPONENT;
+
+      if(!feedback && !m_profiling)
+      {
+        ctc->contract();
+        return false;
+      }
+
+      const vector<Domain*> v_domains = ctc->domains();
+      double volume_before = 0., volume_after = 0.;
+      for(const auto& dom : v_domains)
+        volume_before += dom->compute_volume();
+
+      typedef chrono::steady_clock clock_type;
+      const clock_type::time_point t_start = clock_type::now();
+      ctc->contract();
+      duration = chrono::duration<double>(clock_type::now() - t_start).count();
+
+      for(const auto& dom : v_domains)
+        volume_after += dom->compute_volume();
+      ratio = volume_before > 0. ? std::min(1., volume_after/volume_before) : 1.;
+
+      if(m_profiling)
+      {
+        ctc->m_nb_calls++;
+        ctc->m_cumulated_time += duration;
+        if(volume_after < volume_before)
+        {
+          ctc->m_nb_contractions++;
+          ctc->m_volume_reduction += volume_before - volume_after;
+        }
+      }
+
+      return feedback;
+    }
+
     void ContractorNetwork::reset_value(Domain *dom)
     {
       dom->reset_value();
@@ -252,19 +386,81 @@ namespace codac
       // todo: }
     }
 
+    bool ContractorNetwork::budget_exhausted(const chrono::steady_clock::time_point& t_end)
+    {
+      if(m_budget.cancellation.is_cancelled())
+        m_status = ContractionStatus::CANCELLED;
+
+      else if(m_budget.max_ctc_calls >= 0 && m_nb_ctc_calls >= m_budget.max_ctc_calls)
+        m_status = ContractionStatus::CALLS_LIMIT;
+
+      // The clock is read only if a time limit has been set
+      else if(t_end != chrono::steady_clock::time_point::max() && chrono::steady_clock::now() >= t_end)
+        m_status = ContractionStatus::TIME_LIMIT;
+
+      else
+        return false;
+
+      return true;
+    }
+
+    void ContractorNetwork::build_adjacency()
+    {
+      if(m_adjacency_valid)
+        return;
+
+      m_adj_ctc_offsets.assign(1, 0);
+      m_adj_comp_offsets.assign(1, 0);
+      m_adj_ctc.clear();
+      m_adj_comp.clear();
+      m_adj_ctc_offsets.reserve(m_v_domains.size()+1);
+      m_adj_comp_offsets.reserve(m_v_domains.size()+1);
+
+      for(const auto& dom : m_v_domains)
+      {
+        m_adj_ctc.insert(m_adj_ctc.end(), dom->contractors().begin(), dom->contractors().end());
+        m_adj_ctc_offsets.push_back(m_adj_ctc.size());
+
+        if(dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+        {
+          // Components are the other domains of the component contractor of this vector
+          for(const auto& ctc : dom->contractors())
+            if(ctc->type() == Contractor::Type::T_COMPONENT && ctc->m_v_domains[0] == dom
+              && (int)ctc->m_v_domains.size() == dom->interval_vector().size()+1)
+            {
+              m_adj_comp.insert(m_adj_comp.end(), ctc->m_v_domains.begin()+1, ctc->m_v_domains.end());
+              break;
+            }
+        }
+
+        m_adj_comp_offsets.push_back(m_adj_comp.size());
+      }
+
+      m_adjacency_valid = true;
+    }
+
     void ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
     {
+      build_adjacency();
+      const int id = dom->m_cn_id;
+      assert(id >= 0 && id < (int)m_v_domains.size() && m_v_domains[id] == dom
+        && "domain cannot be found in CN");
+
       double current_volume = dom->compute_volume(); // new volume after contraction
 
-      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio)
+      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio
+        // Limited number of propagations from this domain
+        && (m_budget.max_dom_contractions < 0 || id >= (int)m_v_dom_contractions.size()
+          || m_v_dom_contractions[id]++ < m_budget.max_dom_contractions))
       {
         // We activate each contractor related to these domains, according to graph orientation
 
         // Local deque, for specific order related to this domain
         deque<Contractor*> ctc_deque;
 
-        for(auto& ctc_of_dom : dom->contractors())
+        for(int k = m_adj_ctc_offsets[id] ; k < m_adj_ctc_offsets[id+1] ; k++)
         {
+          Contractor *ctc_of_dom = m_adj_ctc[k];
           if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
           {
             ctc_of_dom->set_active(true);
@@ -274,7 +470,10 @@ namespace codac
 
         // Merging this local deque in the CN one
         for(auto& c : ctc_deque)
-          m_deque.push_front(c);
+          if(m_scheduler)
+            m_scheduler->push(c);
+          else
+            m_deque.push_front(c);
       }
       
       dom->set_volume(current_volume); // updating old volume
@@ -282,13 +481,10 @@ namespace codac
       switch(dom->m_type)
       {
         case Domain::Type::T_INTERVAL_VECTOR:
-          for(int j = 0 ; j < dom->interval_vector().size() ; j++)
-          {
-            DomainHashcode hash(Domain::vector_component(*dom,j));
-            assert(m_map_domains.find(hash) != m_map_domains.end() 
-                    && "component of the domain cannot be found in CN");
-            trigger_ctc_related_to_dom(m_map_domains[hash], ctc_to_avoid);
-          }
+          assert(m_adj_comp_offsets[id+1]-m_adj_comp_offsets[id] == dom->interval_vector().size()
+                  && "components of the domain cannot be found in CN");
+          for(int k = m_adj_comp_offsets[id] ; k < m_adj_comp_offsets[id+1] ; k++)
+            trigger_ctc_related_to_dom(m_adj_comp[k], ctc_to_avoid);
           break;
 
         default:
@@ -297,7 +493,43 @@ namespace codac
       }
     }
 
-    void ContractorNetwork::replace_var_by_dom(Domain var, Domain dom)
+    void ContractorNetwork::trigger_ctc_related_to_ctc_doms(Contractor *ctc)
+    {
+      const vector<Domain*>& v_domains = ctc->m_v_domains;
+
+      if(ctc->type() == Contractor::Type::T_COMPONENT
+        && v_domains.size() > 1 && v_domains[0]->type() == Domain::Type::T_TUBE)
+      {
+        // Component contractor between a tube and its slices:
+        // only the slices impacted by the last changes are considered
+
+        trigger_ctc_related_to_dom(v_domains[0], ctc);
+
+        // The window is specific to this network, the tube may be shared with others
+        Domain *dom = v_domains[0];
+        Tube& x = dom->tube();
+        const Interval changed_tdomain = x.changed_tdomain(dom->m_changes_window_id);
+        dom->m_changes_window_id = x.reset_changed_tdomain();
+
+        if(changed_tdomain.is_empty())
+          return;
+
+        // Slices domains are sorted by time, after the tube domain.
+        // Neighbor slices (sharing a gate) are also considered.
+        vector<Domain*>::const_iterator it = lower_bound(v_domains.begin()+1, v_domains.end(),
+          changed_tdomain.lb(), [](const Domain *d, double t) { return d->slice().tdomain().ub() < t; });
+
+        for( ; it != v_domains.end() && (*it)->slice().tdomain().lb() <= changed_tdomain.ub() ; ++it)
+          trigger_ctc_related_to_dom(*it, ctc);
+      }
+
+      else
+        for(auto& ctc_dom : v_domains) // for each domain related to this contractor
+          // If the domain has "changed" after the contraction
+          trigger_ctc_related_to_dom(ctc_dom, ctc);
+    }
+
+    void ContractorNetwork::replace_var_by_dom(Domain var, Domain dom, bool trigger)
     {
       bool var_fully_present_in_graph = true;
       bool var_partially_present_in_graph = false;
@@ -325,7 +557,7 @@ namespace codac
           {
             // The vector var is added
             add_dom(Domain(var.interval_vector()));
-            return replace_var_by_dom(var, dom);
+            return replace_var_by_dom(var, dom, trigger);
           }
         }
       }
@@ -335,7 +567,11 @@ namespace codac
 
       Domain* var_ptr = m_map_domains[hashcode];
       var_ptr->set_ref_values(dom);
-      trigger_ctc_related_to_dom(var_ptr);
+
+      if(trigger)
+        trigger_ctc_related_to_dom(var_ptr);
+      else
+        var_ptr->set_volume(POS_INFINITY); // unknown volume: considered as contracted at the next binding
 
       switch(var.type())
       {
@@ -348,7 +584,7 @@ namespace codac
             throw Exception(__func__, "the provided IntervalVector does not match the variable dimension");
 
           for(int j = 0 ; j < var.interval_vector().size() ; j++)
-            replace_var_by_dom(Domain(var.interval_vector()[j]), Domain::vector_component(dom,j));
+            replace_var_by_dom(Domain(var.interval_vector()[j]), Domain::vector_component(dom,j), trigger);
 
           break;
 
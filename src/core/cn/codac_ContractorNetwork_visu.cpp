@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdio>
 #include "codac_Tools.h"
 #include "codac_ContractorNetwork.h"
 #include "codac_Exception.h"
@@ -37,10 +38,10 @@ namespace codac
     {
       bool contractor_found = false;
 
-      for(auto& added_ctc : m_map_ctc)
-        if(added_ctc.second->type() == Contractor::Type::T_IBEX && &added_ctc.second->ibex_ctc() == &ctc)
+      for(auto& added_ctc : m_v_ctc)
+        if(added_ctc->type() == Contractor::Type::T_IBEX && &added_ctc->ibex_ctc() == &ctc)
         {
-          added_ctc.second->set_name(name);
+          added_ctc->set_name(name);
           contractor_found = true;
         }
 
@@ -52,10 +53,10 @@ namespace codac
     {
       bool contractor_found = false;
 
-      for(auto& added_ctc : m_map_ctc)
-        if(added_ctc.second->type() == Contractor::Type::T_CODAC && &added_ctc.second->codac_ctc() == &ctc)
+      for(auto& added_ctc : m_v_ctc)
+        if(added_ctc->type() == Contractor::Type::T_CODAC && &added_ctc->codac_ctc() == &ctc)
         {
-          added_ctc.second->set_name(name);
+          added_ctc->set_name(name);
             contractor_found = true;
         }
 
@@ -63,9 +64,9 @@ namespace codac
         throw Exception(__func__, "contractor cannot be found in CN");
     }
 
-    int ContractorNetwork::print_dot_graph(const string& cn_name, const string& layer_model) const
+    int ContractorNetwork::print_dot_graph(const string& cn_name, const string& layer_model, bool show_profiling) const
     {
-      if(m_map_domains.size() > 100 || m_map_ctc.size() > 100)
+      if(m_v_domains.size() > 100 || m_v_ctc.size() > 100)
         cout << "Warning: important number of domains/contractors in the graph, may not be able to generate the diagram." << endl;
 
       ofstream dot_file;
@@ -76,53 +77,74 @@ namespace codac
       dot_file << "  splines=\"compound\"" << endl;
 
       dot_file << endl << "  // Domains nodes" << endl;
-      for(const auto& dom : m_map_domains)
-        dot_file << "  " << ("dom" + std::to_string(dom.second->id())) << " [shape=box, label=\"" << dom.second->dom_name(m_map_domains) << "\"];" << endl;
+      for(const auto& dom : m_v_domains)
+        dot_file << "  " << ("dom" + std::to_string(dom->id())) << " [shape=box, label=\"" << dom->dom_name(m_v_domains) << "\"];" << endl;
+
+      double total_time = 0.;
+      if(show_profiling)
+        for(const auto& ctc : m_v_ctc)
+          total_time += ctc->m_cumulated_time;
 
       dot_file << endl << "  // Contractors nodes" << endl;
-      for(auto& ctc : m_map_ctc)
+      for(auto& ctc : m_v_ctc)
       {
-        dot_file << "  " << ("ctc" + std::to_string(ctc.second->id()))
+        dot_file << "  " << ("ctc" + std::to_string(ctc->id()))
                  // Node style:
                  << " [shape=circle, "
-                 << "label=\"" << ctc.second->name() << "\"];" << endl;
+                 << "label=\"" << ctc->name() << "\"";
+
+        if(show_profiling)
+        {
+          // Profiling overlay: the redder, the more time consuming
+          const ContractorProfile p = ctc->profile();
+          int heat = total_time > 0. ? (int)(255. * p.time / total_time) : 0;
+          char color[8];
+          snprintf(color, sizeof(color), "#FF%02X%02X", 255-heat, 255-heat);
+
+          dot_file << ", style=filled, fillcolor=\"" << color << "\""
+                   << ", xlabel=\"" << p.nb_calls << " calls, "
+                   << (1000.*p.time) << " ms, "
+                   << p.nb_contractions << " contr.\"";
+        }
+
+        dot_file << "];" << endl;
       }
 
       dot_file << endl << "  // Relations" << endl;
-      for(auto& ctc : m_map_ctc)
-        for(const auto& dom : m_map_domains)
-          if(find(dom.second->contractors().begin(), dom.second->contractors().end(), ctc.second) != dom.second->contractors().end())
-            dot_file << "  " << ("ctc" + std::to_string(ctc.second->id())) << " -- " << ("dom" + std::to_string(dom.second->id())) << ";" << endl;
+      for(auto& ctc : m_v_ctc)
+        for(const auto& dom : m_v_domains)
+          if(find(dom->contractors().begin(), dom->contractors().end(), ctc) != dom->contractors().end())
+            dot_file << "  " << ("ctc" + std::to_string(ctc->id())) << " -- " << ("dom" + std::to_string(dom->id())) << ";" << endl;
 
       // Subgraph for clustering components of a same vector
-      for(const auto& dom : m_map_domains)
+      for(const auto& dom : m_v_domains)
       {
-        if(dom.second->type() == Domain::Type::T_INTERVAL_VECTOR)
+        if(dom->type() == Domain::Type::T_INTERVAL_VECTOR)
         {
           dot_file << endl;
-          dot_file << "  subgraph cluster_" << ("dom" + std::to_string(dom.second->id())) << " {" << endl;
+          dot_file << "  subgraph cluster_" << ("dom" + std::to_string(dom->id())) << " {" << endl;
           dot_file << "    color=\"#006680\";" << endl << "    ";
 
           // Adding the main vector
-          dot_file << ("dom" + std::to_string(dom.second->id())) + "; ";
+          dot_file << ("dom" + std::to_string(dom->id())) + "; ";
 
           // Adding its components
           Domain *one_component = nullptr;
-          for(const auto& dom_i : m_map_domains) // todo: a fast get_components method
-            if(dom_i.second->is_component_of(*dom.second))
+          for(const auto& dom_i : m_v_domains) // todo: a fast get_components method
+            if(dom_i->is_component_of(*dom))
             {
-              one_component = dom_i.second;
-              dot_file << ("dom" + std::to_string(dom_i.second->id())) + "; ";
+              one_component = dom_i;
+              dot_file << ("dom" + std::to_string(dom_i->id())) + "; ";
             }
 
           // Adding their component-contractor
           if(one_component) // todo: transform it as an assert
-          for(auto& ctc : m_map_ctc)
-            if(ctc.second->type() == Contractor::Type::T_COMPONENT)
-              for(const auto& dom_i : ctc.second->domains())
+          for(auto& ctc : m_v_ctc)
+            if(ctc->type() == Contractor::Type::T_COMPONENT)
+              for(const auto& dom_i : ctc->domains())
                 if(dom_i == one_component)
                 {
-                  dot_file << ("ctc" + std::to_string(ctc.second->id())) + "; ";
+                  dot_file << ("ctc" + std::to_string(ctc->id())) + "; ";
                   break;
                 }
 
@@ -131,21 +153,21 @@ namespace codac
       }
 
       // Subgraphs for tubes and their slices
-      for(const auto& dom : m_map_domains)
+      for(const auto& dom : m_v_domains)
       {
-        if(dom.second->type() == Domain::Type::T_TUBE)
+        if(dom->type() == Domain::Type::T_TUBE)
         {
           dot_file << endl;
-          dot_file << "  " << ("subgraph cluster_tube" + std::to_string(dom.second->id())) << " {" << endl;
+          dot_file << "  " << ("subgraph cluster_tube" + std::to_string(dom->id())) << " {" << endl;
           dot_file << "    color=\"#BA4E00\";" << endl;
           dot_file << "    ";
 
           // Looking for all domains and contractors exclusively related to this tube
-          for(const auto& ctc : dom.second->contractors())
+          for(const auto& ctc : dom->contractors())
           {
             for(const auto& dom_i : ctc->domains())
             {
-              if(dom_i != dom.second && dom_i->type() != Domain::Type::T_SLICE)
+              if(dom_i != dom && dom_i->type() != Domain::Type::T_SLICE)
                 break; // we are not dealing with the slice-component contractor
 
               // At this point we are dealing with either the tube or its slices
@@ -181,8 +203,8 @@ namespace codac
     {
       str << cn.nb_ctc() << " contractors\n";
       str << cn.nb_dom() << " domains:\n";
-      for(const auto& dom : cn.m_map_domains)
-        str << *dom.second << endl;
+      for(const auto& dom : cn.m_v_domains)
+        str << *dom << endl;
       return str;
     }
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+/**
+ *  ContractorScheduler classes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include "codac_ContractorScheduler.h"
+
+using namespace std;
+
+namespace codac
+{
+  // ContractorScheduler
+
+    ContractorScheduler::~ContractorScheduler()
+    {
+
+    }
+
+    void ContractorScheduler::update(const Contractor *ctc, double duration, double ratio)
+    {
+      // No feedback needed by default
+    }
+
+  // CheapestFirstScheduler
+
+    CheapestFirstScheduler::CheapestFirstScheduler(double smoothing)
+      : m_smoothing(smoothing)
+    {
+      assert(smoothing > 0. && smoothing <= 1. && "invalid smoothing weight");
+    }
+
+    void CheapestFirstScheduler::push(Contractor *ctc)
+    {
+      // Equal costs: first in, first out
+      m_queue.insert(make_pair(cost(ctc), ctc));
+    }
+
+    Contractor* CheapestFirstScheduler::pop()
+    {
+      assert(!m_queue.empty());
+      Contractor *ctc = m_queue.begin()->second;
+      m_queue.erase(m_queue.begin());
+      return ctc;
+    }
+
+    bool CheapestFirstScheduler::empty() const
+    {
+      return m_queue.empty();
+    }
+
+    int CheapestFirstScheduler::size() const
+    {
+      return m_queue.size();
+    }
+
+    void CheapestFirstScheduler::clear()
+    {
+      m_queue.clear();
+    }
+
+    void CheapestFirstScheduler::update(const Contractor *ctc, double duration, double ratio)
+    {
+      unordered_map<const Contractor*,double>::iterator it = m_map_costs.find(ctc);
+      if(it == m_map_costs.end())
+        m_map_costs[ctc] = duration;
+      else
+        it->second = m_smoothing*duration + (1.-m_smoothing)*it->second;
+    }
+
+    double CheapestFirstScheduler::cost(const Contractor *ctc) const
+    {
+      unordered_map<const Contractor*,double>::const_iterator it = m_map_costs.find(ctc);
+      return it == m_map_costs.end() ? 0. : it->second;
+    }
+
+  // LargestRatioFirstScheduler
+
+    void LargestRatioFirstScheduler::push(Contractor *ctc)
+    {
+      // Sorted by ratio of the last contraction: the smaller, the more contracting
+      unordered_map<const Contractor*,double>::const_iterator it = m_map_ratios.find(ctc);
+      m_queue.insert(make_pair(it == m_map_ratios.end() ? 0. : it->second, ctc));
+    }
+
+    Contractor* LargestRatioFirstScheduler::pop()
+    {
+      assert(!m_queue.empty());
+      Contractor *ctc = m_queue.begin()->second;
+      m_queue.erase(m_queue.begin());
+      return ctc;
+    }
+
+    bool LargestRatioFirstScheduler::empty() const
+    {
+      return m_queue.empty();
+    }
+
+    int LargestRatioFirstScheduler::size() const
+    {
+      return m_queue.size();
+    }
+
+    void LargestRatioFirstScheduler::clear()
+    {
+      m_queue.clear();
+    }
+
+    void LargestRatioFirstScheduler::update(const Contractor *ctc, double duration, double ratio)
+    {
+      m_map_ratios[ctc] = ratio;
+    }
+
+  // RoundRobinScheduler
+
+    RoundRobinScheduler::RoundRobinScheduler()
+      : m_v_queues(static_cast<int>(Contractor::Type::NB_TYPES))
+    {
+
+    }
+
+    void RoundRobinScheduler::push(Contractor *ctc)
+    {
+      m_v_queues[static_cast<int>(ctc->type())].push_back(ctc);
+      m_size++;
+    }
+
+    Contractor* RoundRobinScheduler::pop()
+    {
+      assert(m_size > 0);
+
+      while(m_v_queues[m_next_type].empty())
+        m_next_type = (m_next_type + 1) % m_v_queues.size();
+
+      Contractor *ctc = m_v_queues[m_next_type].front();
+      m_v_queues[m_next_type].pop_front();
+      m_next_type = (m_next_type + 1) % m_v_queues.size();
+      m_size--;
+      return ctc;
+    }
+
+    bool RoundRobinScheduler::empty() const
+    {
+      return m_size == 0;
+    }
+
+    int RoundRobinScheduler::size() const
+    {
+      return m_size;
+    }
+
+    void RoundRobinScheduler::clear()
+    {
+      for(auto& q : m_v_queues)
+        q.clear();
+      m_size = 0;
+    }
+}
@@ -0,0 +1,182 @@
+/**
+ *  \file
+ *  ContractorScheduler classes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_CONTRACTORSCHEDULER_H__
+#define __CODAC_CONTRACTORSCHEDULER_H__
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include "codac_Contractor.h"
+
+namespace codac
+{
+  class Contractor;
+
+  /**
+   * \class ContractorScheduler
+   * \brief Queue of active contractors of a ContractorNetwork, defining
+   *        the order in which they are applied during the propagation.
+   *
+   * Custom policies can be implemented by overriding this class.
+   * The scheduler is informed of the cost and the impact of each contraction.
+   */
+  class ContractorScheduler
+  {
+    public:
+
+      /**
+       * \brief ContractorScheduler destructor
+       */
+      virtual ~ContractorScheduler();
+
+      /**
+       * \brief Adds an active contractor in the queue
+       *
+       * \param ctc pointer to the Contractor
+       */
+      virtual void push(Contractor *ctc) = 0;
+
+      /**
+       * \brief Removes the next contractor to be applied from the queue
+       *
+       * \note The queue must not be empty
+       *
+       * \return pointer to the Contractor
+       */
+      virtual Contractor* pop() = 0;
+
+      /**
+       * \brief Returns `true` if no contractor is waiting for process
+       *
+       * \return emptiness test
+       */
+      virtual bool empty() const = 0;
+
+      /**
+       * \brief Returns the number of contractors that are waiting for process
+       *
+       * \return number of active contractors
+       */
+      virtual int size() const = 0;
+
+      /**
+       * \brief Removes all the contractors from the queue
+       */
+      virtual void clear() = 0;
+
+      /**
+       * \brief Informs the scheduler about a contraction that has just been performed
+       *
+       * \note Not called for the symbolic component contractors
+       *
+       * \param ctc pointer to the Contractor that has been applied
+       * \param duration computation time of the contraction, in seconds
+       * \param ratio ratio of the volumes of the domains after/before the contraction,
+       *        \f$r\in[0,1]\f$, \f$r=1\f$ meaning no contraction
+       */
+      virtual void update(const Contractor *ctc, double duration, double ratio);
+  };
+
+  /**
+   * \class CheapestFirstScheduler
+   * \brief Applies first the contractors that have been the cheapest to compute so far.
+   *
+   * The cost of each contractor is a moving average of its measured computation times.
+   * Contractors that have not been applied yet are considered as costless.
+   */
+  class CheapestFirstScheduler : public ContractorScheduler
+  {
+    public:
+
+      /**
+       * \brief Creates a cheapest-first scheduler
+       *
+       * \param smoothing weight \f$\alpha\in]0,1]\f$ of the last measure in the moving average
+       */
+      CheapestFirstScheduler(double smoothing = 0.5);
+
+      void push(Contractor *ctc);
+      Contractor* pop();
+      bool empty() const;
+      int size() const;
+      void clear();
+      void update(const Contractor *ctc, double duration, double ratio);
+
+      /**
+       * \brief Returns the estimated cost of a contractor
+       *
+       * \param ctc pointer to the Contractor
+       * \return the moving average of its computation times, in seconds
+       */
+      double cost(const Contractor *ctc) const;
+
+    protected:
+
+      const double m_smoothing; //!< weight of the last measure in the moving average
+      std::multimap<double,Contractor*> m_queue; //!< active contractors sorted by cost
+      std::unordered_map<const Contractor*,double> m_map_costs; //!< estimated costs
+  };
+
+  /**
+   * \class LargestRatioFirstScheduler
+   * \brief Applies first the contractors that were the most contracting
+   *        during their last call.
+   *
+   * Contractors that have not been applied yet are considered as the most contracting.
+   */
+  class LargestRatioFirstScheduler : public ContractorScheduler
+  {
+    public:
+
+      void push(Contractor *ctc);
+      Contractor* pop();
+      bool empty() const;
+      int size() const;
+      void clear();
+      void update(const Contractor *ctc, double duration, double ratio);
+
+    protected:
+
+      std::multimap<double,Contractor*> m_queue; //!< active contractors sorted by the ratio of their last contraction
+      std::unordered_map<const Contractor*,double> m_map_ratios; //!< ratios of the last contractions
+  };
+
+  /**
+   * \class RoundRobinScheduler
+   * \brief Applies in turn the contractors of each type (component, equality,
+   *        IBEX, Codac, sub-networks), in a first-in first-out order for each type.
+   */
+  class RoundRobinScheduler : public ContractorScheduler
+  {
+    public:
+
+      /**
+       * \brief Creates a round-robin scheduler
+       */
+      RoundRobinScheduler();
+
+      void push(Contractor *ctc);
+      Contractor* pop();
+      bool empty() const;
+      int size() const;
+      void clear();
+
+    protected:
+
+      std::vector<std::deque<Contractor*> > m_v_queues; //!< one queue per type of contractor
+      int m_next_type = 0; //!< type of the next contractor to be applied
+      int m_size = 0; //!< total number of active contractors
+  };
+}
+
+#endif
@@ -519,50 +519,19 @@ namespace codac
         return interval_vector().volume();
 
       case Type::T_SLICE:
-      {
-        double vol = slice().volume();
-
-        // todo: clean the following:
-
-        if(slice().input_gate().is_empty())
-          vol += 0.;
-        else if(slice().input_gate().is_unbounded())
-          vol += 999999.; // todo: manage the unbounded case for fixed point detection
-        else
-          vol += slice().input_gate().diam();
-
-        if(slice().output_gate().is_empty())
-          vol += 0.;
-        else if(slice().output_gate().is_unbounded())
-          vol += 999999.; // todo: manage the unbounded case for fixed point detection
-        else
-          vol += slice().output_gate().diam();
-
-        return vol;
-      }
+        return slice().volume()
+          + Slice::bounded_diam(slice().input_gate())
+          + Slice::bounded_diam(slice().output_gate());
 
       case Type::T_TUBE:
-      {
-        double vol = tube().volume();
-        vol += tube().first_slice()->input_gate().diam();
-        for(const Slice *s = tube().first_slice() ; s ; s = s->next_slice())
-          vol += s->output_gate().diam();
-        return vol;
-      }
+        // Incrementally updated by the slices: constant time
+        return tube().tracked_volume();
 
       case Type::T_TUBE_VECTOR:
       {
-        // todo: improve this
         double vol = 0.;
-
         for(int i = 0 ; i < tube_vector().size() ; i++)
-        {
-          vol += tube_vector()[i].volume();
-          vol += tube_vector()[i].first_slice()->input_gate().diam();
-          for(const Slice *s = tube_vector()[i].first_slice() ; s ; s = s->next_slice())
-            vol += s->output_gate().diam();
-        }
-        
+          vol += tube_vector()[i].tracked_volume();
         return vol;
       }
 
@@ -917,7 +886,7 @@ namespace codac
     }
   }
   
-  const string Domain::var_name(const map<DomainHashcode,Domain*> m_domains) const
+  const string Domain::var_name(const vector<Domain*>& v_domains) const
   {
     string output_name = m_name;
 
@@ -928,15 +897,15 @@ namespace codac
         // The variable may be a component of a vector one
         case Type::T_INTERVAL:
         case Type::T_TUBE:
-          for(const auto& dom : m_domains) // looking for this possible vector
+          for(const auto& dom : v_domains) // looking for this possible vector
           {
-            if(dom.second != this)
+            if(dom != this)
             {
-              if(dom.second->type() == Type::T_INTERVAL_VECTOR || dom.second->type() == Type::T_TUBE_VECTOR)
+              if(dom->type() == Type::T_INTERVAL_VECTOR || dom->type() == Type::T_TUBE_VECTOR)
               {
                 int component_id = 0;
-                if(is_component_of(*dom.second, component_id))
-                  output_name = dom.second->var_name(m_domains) + std::to_string(component_id+1); // adding component id
+                if(is_component_of(*dom, component_id))
+                  output_name = dom->var_name(v_domains) + std::to_string(component_id+1); // adding component id
               }
             }
           }
@@ -944,14 +913,14 @@ namespace codac
 
         // The variable may be a slice of a tube
         case Type::T_SLICE:
-          for(const auto& dom : m_domains) // looking for this possible vector
+          for(const auto& dom : v_domains) // looking for this possible vector
           {
-            if(dom.second != this && dom.second->type() == Type::T_TUBE)
+            if(dom != this && dom->type() == Type::T_TUBE)
             {
               int slice_id = 0;
-              if(is_slice_of(*dom.second, slice_id))
+              if(is_slice_of(*dom, slice_id))
               {
-                output_name = dom.second->var_name(m_domains) + "^{(" + std::to_string(slice_id+1) + ")}"; // adding slice id
+                output_name = dom->var_name(v_domains) + "^{(" + std::to_string(slice_id+1) + ")}"; // adding slice id
               }
             }
           }
@@ -976,7 +945,7 @@ namespace codac
           {
             if(dom != this)
             {
-              string dom_var_name = dom->var_name(m_domains);
+              string dom_var_name = dom->var_name(v_domains);
               if(!dom_var_name.empty() && dom_var_name.find("?") == string::npos)
                 output_name += (!output_name.empty() ? "/" : "") + dom_var_name;
             }
@@ -1077,9 +1046,9 @@ namespace codac
     return n;
   }
 
-  const string Domain::dom_name(const map<DomainHashcode,Domain*> m_domains) const
+  const string Domain::dom_name(const vector<Domain*>& v_domains) const
   {
-    string output_name = var_name(m_domains);
+    string output_name = var_name(v_domains);
 
     switch(m_type)
     {
@@ -103,7 +103,7 @@ namespace codac
       void add_data(double t, const Interval& y, ContractorNetwork& cn);
       void add_data(double t, const IntervalVector& y, ContractorNetwork& cn);
 
-      const std::string dom_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string dom_name(const std::vector<Domain*>& v_domains) const;
       void set_name(const std::string& name);
 
       static bool all_dyn(const std::vector<Domain>& v_domains);
@@ -119,7 +119,7 @@ namespace codac
     protected:
 
       Domain(Type type, MemoryRef memory_type);
-      const std::string var_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string var_name(const std::vector<Domain*>& v_domains) const;
 
       // Theoretical type of domain
 
@@ -181,6 +181,8 @@ namespace codac
 
       std::string m_name;
       int m_dom_id;
+      int m_cn_id = -1; //!< dense index of this domain in its ContractorNetwork
+      std::uint64_t m_changes_window_id = 0; //!< window of the changes of a tube read by the network, see Tube::changed_tdomain()
 
       static int dom_counter;
 
@@ -24,49 +24,46 @@ namespace codac
   ContractorHashcode::ContractorHashcode(const Contractor& ctc)
   {
     if(ctc.m_type == Contractor::Type::T_CN)
-    {
-      m_ptr = new std::uintptr_t[1];
-      m_ptr[0] = reinterpret_cast<std::uintptr_t>(&ctc.m_cn_ctc.get());
-    }
+      m_ptr.push_back(reinterpret_cast<std::uintptr_t>(&ctc.m_cn_ctc.get()));
 
     else
     {
-      m_n = ctc.m_v_domains.size()+1;
-      m_ptr = new std::uintptr_t[m_n];
+      m_ptr.resize(ctc.m_v_domains.size()+1);
+      const size_t n = m_ptr.size();
 
-      for(size_t i = 0 ; i < m_n-1 ; i++)
+      for(size_t i = 0 ; i < n-1 ; i++)
         m_ptr[i] = DomainHashcode::uintptr(*ctc.m_v_domains[i]);
 
       switch(ctc.m_type)
       {
         case Contractor::Type::T_EQUALITY:
-          m_ptr[m_n-1] = 0; // todo: check this
+          m_ptr[n-1] = 0; // todo: check this
           break;
 
         case Contractor::Type::T_COMPONENT:
-          m_ptr[m_n-1] = 1; // todo: check this
+          m_ptr[n-1] = 1; // todo: check this
           break;
           
         case Contractor::Type::T_IBEX:
-          m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
-          assert(m_ptr[m_n-1] > 4); // reserved codes
+          m_ptr[n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
+          assert(m_ptr[n-1] > 4); // reserved codes
           break;
 
         case Contractor::Type::T_CODAC:
 
           if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcEval))
-            m_ptr[m_n-1] = 2;
+            m_ptr[n-1] = 2;
 
           else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDeriv))
-            m_ptr[m_n-1] = 3;
+            m_ptr[n-1] = 3;
 
           else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDist))
-            m_ptr[m_n-1] = 4;
+            m_ptr[n-1] = 4;
 
           else
           {
-            m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
-            assert(m_ptr[m_n-1] > 4); // reserved codes
+            m_ptr[n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
+            assert(m_ptr[n-1] > 4); // reserved codes
           }
 
           break;
@@ -79,15 +76,21 @@ namespace codac
 
   bool ContractorHashcode::operator<(const ContractorHashcode& a) const
   {
-    for(size_t i = 0 ; i < std::min(m_n, a.m_n) ; i++)
-    {
-      if(m_ptr[i] == a.m_ptr[i])
-        continue;
+    return m_ptr < a.m_ptr;
+  }
 
-      return m_ptr[i] < a.m_ptr[i];
-    }
+  bool ContractorHashcode::operator==(const ContractorHashcode& a) const
+  {
+    return m_ptr == a.m_ptr;
+  }
 
-    return false;
+  size_t ContractorHashcode::hash() const
+  {
+    // Combination of the hashes of the pointers (boost::hash_combine)
+    size_t h = m_ptr.size();
+    for(const auto& p : m_ptr)
+      h ^= std::hash<std::uintptr_t>()(p) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
   }
 
   // DomainHashcode class
@@ -102,6 +105,16 @@ namespace codac
     return m_ptr < a.m_ptr;
   }
 
+  bool DomainHashcode::operator==(const DomainHashcode& a) const
+  {
+    return m_ptr == a.m_ptr;
+  }
+
+  size_t DomainHashcode::hash() const
+  {
+    return std::hash<std::uintptr_t>()(m_ptr);
+  }
+
   uintptr_t DomainHashcode::uintptr(const Domain& dom)
   {
     uintptr_t ptr = 0;
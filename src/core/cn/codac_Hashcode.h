@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <vector>
 
 namespace codac
 {
@@ -27,11 +28,12 @@ namespace codac
 
       ContractorHashcode(const Contractor& ctc);
       bool operator<(const ContractorHashcode& a) const;
+      bool operator==(const ContractorHashcode& a) const;
+      std::size_t hash() const;
 
     protected:
 
-      size_t m_n;
-      std::uintptr_t *m_ptr;
+      std::vector<std::uintptr_t> m_ptr;
   };
 
   class DomainHashcode
@@ -40,6 +42,8 @@ namespace codac
 
       DomainHashcode(const Domain& dom);
       bool operator<(const DomainHashcode& a) const;
+      bool operator==(const DomainHashcode& a) const;
+      std::size_t hash() const;
 
       static std::uintptr_t uintptr(const Domain& dom);
 
@@ -59,6 +63,24 @@ namespace std
       return codac::DomainHashcode::uintptr(dom);
     }
   };
+
+  template <>
+  struct hash<codac::DomainHashcode>
+  {
+    std::size_t operator()(const codac::DomainHashcode& h) const
+    {
+      return h.hash();
+    }
+  };
+
+  template <>
+  struct hash<codac::ContractorHashcode>
+  {
+    std::size_t operator()(const codac::ContractorHashcode& h) const
+    {
+      return h.hash();
+    }
+  };
 }
 
 
@@ -8,16 +8,22 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <thread>
+#include <algorithm>
 #include "codac_CtcDeriv.h"
 #include "codac_ConvexPolygon.h"
 #include "codac_Domain.h"
 #include "codac_DomainsTypeException.h"
+#include "codac_Exception.h"
+#include "codac_Tools.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  #define MIN_SLICES_PER_THREAD 1024 // below, the sweep is not worth a thread
+
   CtcDeriv::CtcDeriv()
     : DynCtc(false)
   {
@@ -74,16 +80,45 @@ namespace codac
   }
 
   void CtcDeriv::contract(Tube& x, const Tube& v, TimePropag t_propa)
+  {
+    contract_sweeps(x, v, t_propa, m_nb_threads);
+  }
+
+  void CtcDeriv::contract_sweeps(Tube& x, const Tube& v, TimePropag t_propa, int nb_threads)
   {
     assert(x.tdomain() == v.tdomain());
     assert(Tube::same_slicing(x, v));
+
+    // Slices outside the restricted tdomain are not visited
+    const Interval tdomain = x.tdomain() & m_restricted_tdomain;
+    if(tdomain.is_empty())
+      return;
+    const bool restricted = tdomain != x.tdomain();
+
+    if(nb_threads > 1 && !restricted && x.nb_slices() >= 2*MIN_SLICES_PER_THREAD)
+    {
+      if(t_propa & TimePropag::FORWARD)
+        contract_chunks(x, v, true, nb_threads);
+      if(t_propa & TimePropag::BACKWARD)
+        contract_chunks(x, v, false, nb_threads);
+      return;
+    }
     
     if(t_propa & TimePropag::FORWARD)
     {
       Slice *s_x = x.first_slice();
       const Slice *s_v = v.first_slice();
 
-      while(s_x)
+      if(restricted)
+      {
+        int i = x.time_to_index(tdomain.lb());
+        if(i > 0 && x.slice(i-1)->tdomain().intersects(tdomain))
+          i--; // the previous slice shares the gate at t=tdomain.lb()
+        s_x = x.slice(i);
+        s_v = v.slice(i);
+      }
+
+      while(s_x && s_x->tdomain().lb() <= tdomain.ub())
       {
         assert(s_v);
         contract(*s_x, *s_v, t_propa);
@@ -97,7 +132,14 @@ namespace codac
       Slice *s_x = x.last_slice();
       const Slice *s_v = v.last_slice();
 
-      while(s_x)
+      if(restricted)
+      {
+        int i = x.time_to_index(tdomain.ub());
+        s_x = x.slice(i);
+        s_v = v.slice(i);
+      }
+
+      while(s_x && s_x->tdomain().ub() >= tdomain.lb())
       {
         assert(s_v);
         contract(*s_x, *s_v, t_propa);
@@ -113,33 +155,122 @@ namespace codac
     assert(x.tdomain() == v.tdomain());
     assert(TubeVector::same_slicing(x, v));
 
-    for(int i = 0 ; i < x.size() ; i++)
-      contract(x[i], v[i], t_propa);
+    // Components are independent: the threads are shared among them
+    const int nb_chunks = std::min(m_nb_threads, x.size());
+    const int nb_threads = std::max(1, m_nb_threads / nb_chunks);
+
+    Tools::parallel_chunks(x.size(), nb_chunks, [&](int, int begin, int end)
+    {
+      for(int i = begin ; i < end ; i++)
+        contract_sweeps(x[i], v[i], t_propa, nb_threads);
+    });
   }
 
   void CtcDeriv::contract(codac2::Tube<Interval>& x, const codac2::Tube<Interval>& v, TimePropag t_propa)
   {
-    Tube _x = codac2::to_codac1(x);
-    Tube _v = codac2::to_codac1(v);
-    contract(_x,_v,t_propa);
-    x &= codac2::to_codac2(_x);
+    contract_codac2(x, 0, v, 0, t_propa);
   }
 
   void CtcDeriv::contract(codac2::Tube<IntervalVector>& xv, TimePropag t_propa)
   {
-    Tube x = codac2::to_codac1(xv)[0];
-    Tube v = codac2::to_codac1(xv)[1];
-    contract(x,v,t_propa);
-    xv &= codac2::to_codac2(TubeVector({x,v}));
+    assert(xv.size() == 2);
+    contract_codac2(xv, 0, xv, 1, t_propa);
   }
   
   void CtcDeriv::contract(codac2::Tube<IntervalVector>& x, int i, codac2::Tube<IntervalVector>& v, int j, TimePropag t_propa)
   {
-    TubeVector _x = codac2::to_codac1(x);
-    TubeVector _v = codac2::to_codac1(v);
-    contract(_x[i],_v[j],t_propa);
-    x &= codac2::to_codac2(_x);
-    v &= codac2::to_codac2(_v);
+    assert(i >= 0 && i < (int)x.size() && j >= 0 && j < (int)v.size());
+    contract_codac2(x, i, v, j, t_propa);
+  }
+
+  // Access to the components of codac2 slices, for scalar and vector tubes
+
+  static const Interval& component(const Interval& x, size_t)
+  {
+    return x;
+  }
+
+  static const Interval& component(const IntervalVector& x, size_t i)
+  {
+    return x[i];
+  }
+
+  static void set_component(codac2::Slice<Interval>& s, size_t, const Interval& xi)
+  {
+    s.set(xi);
+  }
+
+  static void set_component(codac2::Slice<IntervalVector>& s, size_t i, const Interval& xi)
+  {
+    // The whole vector is set, for the gates to be updated
+    IntervalVector y(s.codomain());
+    y[i] = xi;
+    s.set(y);
+  }
+
+  template<typename T, typename V>
+  void CtcDeriv::contract_codac2(codac2::Tube<T>& x, size_t i, const codac2::Tube<V>& v, size_t j, TimePropag t_propa)
+  {
+    assert(codac2::TDomain::are_same(x.tdomain(), v.tdomain()));
+
+    // Slices of the tubes, gates and temporally unbounded slices excluded
+    vector<codac2::Slice<T>*> v_sx;
+    for(auto& s : x)
+      if(!s.is_gate() && !s.t0_tf().is_unbounded())
+        v_sx.push_back(&s);
+
+    vector<const codac2::Slice<V>*> v_sv;
+    for(const auto& s : v)
+      if(!s.is_gate() && !s.t0_tf().is_unbounded())
+        v_sv.push_back(&s);
+
+    assert(v_sx.size() == v_sv.size());
+    if(v_sx.empty())
+      return;
+
+    // Envelope of the slice that precedes (or follows) a slice, beyond a possible gate
+    auto neighbour_envelope = [&](codac2::Slice<T>* s_n, bool prev)
+    {
+      if(s_n && s_n->is_gate())
+        s_n = prev ? s_n->prev_slice_ptr() : s_n->next_slice_ptr();
+      if(!s_n || s_n->t0_tf().is_unbounded())
+        return Interval::ALL_REALS;
+      return component(s_n->codomain(), i);
+    };
+
+    // Copies of the slices, out of any tube, on which the contraction rule is applied
+    Slice x_k(v_sx[0]->t0_tf()), v_k(v_sx[0]->t0_tf());
+
+    auto contract_k = [&](size_t k)
+    {
+      codac2::Slice<T>& s = *v_sx[k];
+      if(!s.t0_tf().intersects(m_restricted_tdomain))
+        return;
+
+      x_k.set_tdomain(s.t0_tf());
+      x_k.set_envelope(component(s.codomain(), i), false);
+      x_k.set_input_gate(component(s.input_gate(), i), false);
+      x_k.set_output_gate(component(s.output_gate(), i), false);
+      v_k.set_tdomain(s.t0_tf());
+      v_k.set_envelope(component(v_sv[k]->codomain(), j), false);
+
+      codac2::Slice<T> *prev = s.prev_slice_ptr(), *next = s.next_slice_ptr();
+      contract_slice(x_k, v_k, neighbour_envelope(prev, true), neighbour_envelope(next, false));
+
+      set_component(s, i, x_k.codomain());
+      if(prev && prev->is_gate())
+        set_component(*prev, i, x_k.input_gate());
+      if(next && next->is_gate())
+        set_component(*next, i, x_k.output_gate());
+    };
+
+    if(t_propa & TimePropag::FORWARD)
+      for(size_t k = 0 ; k < v_sx.size() ; k++)
+        contract_k(k);
+
+    if(t_propa & TimePropag::BACKWARD)
+      for(size_t k = v_sx.size() ; k-- > 0 ; )
+        contract_k(k);
   }
 
   void CtcDeriv::contract(Slice& x, const Slice& v, TimePropag t_propa)
@@ -163,6 +294,18 @@ namespace codac
     // todo: the fwd/bwd way of propag. is lost in this procedure
     // Restore this feature? Use it in CN only?
 
+    contract_slice(x, v,
+      x.prev_slice() ? x.prev_slice()->codomain() : Interval::ALL_REALS,
+      x.next_slice() ? x.next_slice()->codomain() : Interval::ALL_REALS);
+
+    assert(volume >= x.volume() + v.volume() && "contraction rule not respected");
+  }
+
+  void CtcDeriv::contract_slice(Slice& x, const Slice& v, const Interval& prev_envelope, const Interval& next_envelope)
+  {
+    // Gates are intersected with the envelopes of the neighbours, as done by the
+    // setters of the slice when the neighbours exist
+
     Interval ingate = x.input_gate();
     Interval outgate = x.output_gate();
     Interval envelope = x.codomain();
@@ -181,8 +324,8 @@ namespace codac
       x.set_envelope(envelope);
 
       // Gates needed for polygon computation
-      x.set_input_gate(ingate);
-      x.set_output_gate(outgate);
+      x.set_input_gate(ingate & prev_envelope);
+      x.set_output_gate(outgate & next_envelope);
 
       // Optimal envelope
       envelope &= x.polygon(v).box()[1];
@@ -203,10 +346,148 @@ namespace codac
     }
 
     x.set_envelope(envelope);
-    x.set_input_gate(ingate);
-    x.set_output_gate(outgate);
+    x.set_input_gate(ingate & prev_envelope);
+    x.set_output_gate(outgate & next_envelope);
+  }
 
-    assert(volume >= x.volume() + v.volume() && "contraction rule not respected");
+  void CtcDeriv::contract_chunks(Tube& x, const Tube& v, bool forward, int nb_threads)
+  {
+    assert(Tube::same_slicing(x, v));
+    const int n = x.nb_slices();
+    if(v.nb_slices() != n)
+      throw Exception(__func__, "x and v must share the same slicing");
+    const int nb_chunks = std::max(1, std::min(nb_threads, n / MIN_SLICES_PER_THREAD));
+
+    vector<Slice*> v_sx(n);
+    vector<const Slice*> v_sv(n);
+    Slice *s_x = x.first_slice();
+    const Slice *s_v = v.first_slice();
+    for(int k = 0 ; k < n ; k++, s_x = s_x->next_slice(), s_v = s_v->next_slice())
+    {
+      v_sx[k] = s_x;
+      v_sv[k] = s_v;
+    }
+
+    // Contracted values, the slices of the tube being only read until the end
+    vector<Interval> v_envelope(n), v_ingate(n), v_outgate(n);
+
+    // Contraction of a copy of the slice k, given the values of the previous
+    // slice in the way of propagation: its envelope and their shared gate
+    auto contract_copy = [&](Slice& copy, int k, const Interval& envelope, const Interval& gate)
+    {
+      copy.set_tdomain(v_sx[k]->tdomain());
+      copy.set_envelope(v_sx[k]->codomain(), false);
+      copy.set_input_gate(forward ? gate : v_sx[k]->input_gate(), false);
+      copy.set_output_gate(forward ? v_sx[k]->output_gate() : gate, false);
+
+      contract_slice(copy, *v_sv[k],
+        k == 0 ? Interval::ALL_REALS : (forward ? envelope : v_sx[k-1]->codomain()),
+        k == n-1 ? Interval::ALL_REALS : (forward ? v_sx[k+1]->codomain() : envelope));
+
+      v_envelope[k] = copy.codomain();
+      v_ingate[k] = copy.input_gate();
+      v_outgate[k] = copy.output_gate();
+    };
+
+    // Sweep on the chunk [begin,end[, stopped when meeting the values of the previous sweep
+    auto sweep = [&](int begin, int end, Interval envelope, Interval gate, bool stop_if_unchanged)
+    {
+      Slice copy(x.tdomain());
+
+      for(int j = 0 ; j < end-begin ; j++)
+      {
+        const int k = forward ? begin+j : end-1-j;
+        const Interval prev_envelope = v_envelope[k], prev_gate = forward ? v_outgate[k] : v_ingate[k];
+
+        contract_copy(copy, k, envelope, gate);
+        envelope = v_envelope[k];
+        gate = forward ? v_outgate[k] : v_ingate[k];
+
+        if(stop_if_unchanged && envelope == prev_envelope && gate == prev_gate)
+          break; // the next values do not change
+      }
+    };
+
+    // First contraction of the chunks from the current values of the tube
+    // (these values are the final ones for the first chunk in the way of propagation)
+    vector<int> v_begin(nb_chunks), v_end(nb_chunks);
+    vector<Interval> v_in_envelope(nb_chunks), v_in_gate(nb_chunks);
+
+    Tools::parallel_chunks(n, nb_chunks, [&](int c, int begin, int end)
+    {
+      v_begin[c] = begin;
+      v_end[c] = end;
+      v_in_envelope[c] = forward ? (begin > 0 ? v_sx[begin-1]->codomain() : Interval::ALL_REALS)
+                                 : (end < n ? v_sx[end]->codomain() : Interval::ALL_REALS);
+      v_in_gate[c] = forward ? v_sx[begin]->input_gate() : v_sx[end-1]->output_gate();
+      sweep(begin, end, v_in_envelope[c], v_in_gate[c], false);
+    });
+
+    // Chunks are contracted again until the values at their borders are stable:
+    // at worst, the chunk c is exact after c iterations
+    vector<char> v_update(nb_chunks);
+    bool updated;
+
+    do
+    {
+      updated = false;
+
+      for(int c = 0 ; c < nb_chunks ; c++)
+      {
+        v_update[c] = false;
+        if(forward ? c == 0 : c == nb_chunks-1)
+          continue;
+
+        const int k = forward ? v_begin[c]-1 : v_end[c];
+        const Interval& gate = forward ? v_outgate[k] : v_ingate[k];
+
+        if(v_envelope[k] != v_in_envelope[c] || gate != v_in_gate[c])
+        {
+          v_in_envelope[c] = v_envelope[k];
+          v_in_gate[c] = gate;
+          v_update[c] = true;
+          updated = true;
+        }
+      }
+
+      if(updated)
+        Tools::parallel_chunks(n, nb_chunks, [&](int c, int begin, int end)
+        {
+          if(v_update[c])
+            sweep(begin, end, v_in_envelope[c], v_in_gate[c], true);
+        });
+
+    } while(updated);
+
+    // Update of the slices, the last gate in the way of propagation being
+    // the one computed by the last contraction
+    for(int k = 0 ; k < n ; k++)
+    {
+      v_sx[k]->set_envelope(v_envelope[k], false);
+      if(forward)
+        v_sx[k]->set_input_gate(v_ingate[k], false);
+      else
+        v_sx[k]->set_output_gate(v_outgate[k], false);
+    }
+
+    if(forward)
+      v_sx[n-1]->set_output_gate(v_outgate[n-1], false);
+    else
+      v_sx[0]->set_input_gate(v_ingate[0], false);
+  }
+
+  void CtcDeriv::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0 && "invalid number of threads");
+
+    if(nb_threads == 0)
+      nb_threads = std::max(1, (int)thread::hardware_concurrency());
+    m_nb_threads = nb_threads;
+  }
+
+  int CtcDeriv::nb_threads() const
+  {
+    return m_nb_threads;
   }
 
   void CtcDeriv::contract_gates(Slice& x, const Slice& v)
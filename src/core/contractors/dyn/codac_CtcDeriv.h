@@ -87,8 +87,80 @@ namespace codac
        */
       void contract(Slice& x, const Slice& v, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
 
+      /**
+       * \brief Sets the number of threads used for the contraction of tubes
+       *
+       * Components of tube vectors are contracted simultaneously. The sweeps on
+       * a scalar tube are split into chunks of slices processed simultaneously,
+       * see contract_chunks(). In both cases, the result is the same as the one
+       * of a sequential contraction.
+       *
+       * \param nb_threads number of threads, 0 for the hardware concurrency, 1 for a sequential contraction
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Returns the number of threads used for the contraction of tubes
+       *
+       * \return number of threads
+       */
+      int nb_threads() const;
+
     protected:
 
+      /**
+       * \brief Forward and/or backward sweeps on the slices of a tube
+       *
+       * \param x the scalar tube \f$[x](\cdot)\f$
+       * \param v the scalar derivative tube \f$[v](\cdot)\f$
+       * \param t_propa the temporal ways of propagation
+       * \param nb_threads number of threads for the sweeps
+       */
+      void contract_sweeps(Tube& x, const Tube& v, TimePropag t_propa, int nb_threads);
+
+      /**
+       * \brief Sweep on the slices of a tube, with chunks of slices processed simultaneously
+       *
+       * Each chunk is first contracted from the current values of the gate and the
+       * envelope it shares with the previous chunk (in the way of propagation).
+       * Chunks are then contracted again from the values computed by their neighbours,
+       * until these values are stable: a new contraction stops as soon as it
+       * meets the values of the previous one. Contracted values are stored, the
+       * slices are updated once at the end. The result is the same as the one
+       * of a sequential sweep.
+       *
+       * \param x the scalar tube \f$[x](\cdot)\f$
+       * \param v the scalar derivative tube \f$[v](\cdot)\f$, with the same slicing
+       * \param forward the way of propagation
+       * \param nb_threads number of threads
+       */
+      void contract_chunks(Tube& x, const Tube& v, bool forward, int nb_threads);
+
+      /**
+       * \brief Contracts a slice, the envelopes of its neighbours being given
+       *
+       * \note This allows the contraction of a copy of a slice, out of its tube.
+       *
+       * \param x the slice \f$\llbracket x\rrbracket(\cdot)\f$
+       * \param v the derivative slice \f$\llbracket v\rrbracket(\cdot)\f$
+       * \param prev_envelope envelope of the previous slice, or \f$(-\infty,\infty)\f$
+       * \param next_envelope envelope of the next slice, or \f$(-\infty,\infty)\f$
+       */
+      void contract_slice(Slice& x, const Slice& v, const Interval& prev_envelope, const Interval& next_envelope);
+
+      /**
+       * \brief Contracts in place a component of a codac2 tube with respect to
+       *        a component of its derivative, with the contraction rule of the slices
+       *
+       * \param x the tube \f$[\mathbf{x}](\cdot)\f$
+       * \param i the component of \f$[\mathbf{x}](\cdot)\f$ (0 for scalar tubes)
+       * \param v the derivative tube \f$[\mathbf{v}](\cdot)\f$, on the same tdomain
+       * \param j the component of \f$[\mathbf{v}](\cdot)\f$ (0 for scalar tubes)
+       * \param t_propa the temporal ways of propagation
+       */
+      template<typename T, typename V>
+      void contract_codac2(codac2::Tube<T>& x, size_t i, const codac2::Tube<V>& v, size_t j, TimePropag t_propa);
+
       /**
        * \brief Contracts input and output gates of a slice regarding its derivative set
        *
@@ -104,6 +176,8 @@ namespace codac
       
       friend class CtcEval; // contract_gates used by CtcEval
 
+      int m_nb_threads = 1; //!< number of threads for the contraction of tubes
+
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
       friend class ContractorNetwork;
@@ -20,6 +20,26 @@ using namespace ibex;
 
 namespace codac
 {
+  // Applies f on the envelopes and gates of the slices of x over tdomain (and on the
+  // neighbour slices sharing a gate), instead of sweeping the whole tube
+  template<typename F>
+  static void map_slices(Tube& x, const Interval& tdomain, const F& f)
+  {
+    if(tdomain.is_empty())
+      return;
+
+    Slice *s = x.slice(tdomain.lb());
+    if(s->prev_slice() && s->tdomain().lb() == tdomain.lb())
+      s = s->prev_slice();
+
+    for( ; s && s->tdomain().lb() <= tdomain.ub() ; s = s->next_slice())
+    {
+      s->set_envelope(f(s->codomain()));
+      s->set_input_gate(f(s->input_gate()));
+      s->set_output_gate(f(s->output_gate()));
+    }
+  }
+
   CtcEval::CtcEval()
     : DynCtc(true) // inter-temporal as [t] may involve several times
   {
@@ -92,6 +112,7 @@ namespace codac
     }
 
     bool merge_after_ctc = m_preserve_slicing && !y.gate_exists(t);
+    const double y_timestep = y.timestep(), w_timestep = w.timestep();
 
     z &= y.interpol(t, w);
     y.set(z, t);
@@ -126,6 +147,10 @@ namespace codac
 
         y.delete_synthesis_tree(); // todo: update tree if created, instead of delete
         w.delete_synthesis_tree(); // todo: update tree if created, instead of delete
+
+        // The initial slicing is back: uniform tubes keep their fast indexing
+        y.m_timestep = y_timestep;
+        w.m_timestep = w_timestep;
     }
 
     if(z.is_empty() || y.is_empty())
@@ -157,8 +182,13 @@ namespace codac
     if(t.is_degenerated())
       return contract(t.lb(), z, y, w);
     
-    y &= Interval(-BOUNDED_INFINITY,BOUNDED_INFINITY); // todo: remove this
-    w &= Interval(-BOUNDED_INFINITY,BOUNDED_INFINITY); // todo: remove this
+    // Without propagation, only the slices over [t] are involved in the evaluation.
+    // Otherwise CtcDeriv sweeps the whole tube, which is then bounded and unbounded
+    // as a whole: values derived from the bounded gates must not remain outside [t]
+    const Interval ctc_tdomain = m_propagation_enabled ? y.tdomain() : t & y.tdomain();
+    const auto bounded = [](const Interval& x) { return x & Interval(-BOUNDED_INFINITY,BOUNDED_INFINITY); };
+    map_slices(y, ctc_tdomain, bounded); // todo: remove this
+    map_slices(w, ctc_tdomain, bounded); // todo: remove this
 
     t &= y.tdomain();
     t &= y.invert(z, w, t);
@@ -173,6 +203,7 @@ namespace codac
       if(!z.is_empty())
       {
         vector<double> v_gates_to_remove;
+        const double y_timestep = y.timestep(), w_timestep = w.timestep();
         if(m_preserve_slicing)
         {
           if(!y.gate_exists(t.lb())) // will exist then
@@ -299,27 +330,23 @@ namespace codac
               y.delete_synthesis_tree(); // todo: update tree if created, instead of delete
               w.delete_synthesis_tree(); // todo: update tree if created, instead of delete
           }
+
+          if(m_preserve_slicing) // the initial slicing is back: uniform tubes keep their fast indexing
+          {
+            y.m_timestep = y_timestep;
+            w.m_timestep = w_timestep;
+          }
       }
 
       // todo: remove this (or use Polygons with truncation)
 
-        for(Slice *s = y.first_slice() ; s ; s = s->next_slice())
+        map_slices(y, ctc_tdomain, [](const Interval& x)
         {
-          Interval envelope = s->codomain();
-          if(envelope.ub() == BOUNDED_INFINITY) envelope = Interval(envelope.lb(),POS_INFINITY);
-          if(envelope.lb() == -BOUNDED_INFINITY) envelope |= Interval(NEG_INFINITY,envelope.ub());
-          s->set_envelope(envelope);
-
-          Interval ingate = s->input_gate();
-          if(ingate.ub() == BOUNDED_INFINITY) ingate = Interval(ingate.lb(),POS_INFINITY);
-          if(ingate.lb() == -BOUNDED_INFINITY) ingate = Interval(NEG_INFINITY,ingate.ub());
-          s->set_input_gate(ingate);
-
-          Interval outgate = s->output_gate();
-          if(outgate.ub() == BOUNDED_INFINITY) outgate = Interval(outgate.lb(),POS_INFINITY);
-          if(outgate.lb() == -BOUNDED_INFINITY) outgate = Interval(NEG_INFINITY,outgate.ub());
-          s->set_output_gate(outgate);
-        }
+          Interval unbounded(x);
+          if(unbounded.ub() == BOUNDED_INFINITY) unbounded = Interval(unbounded.lb(),POS_INFINITY);
+          if(unbounded.lb() == -BOUNDED_INFINITY) unbounded |= Interval(NEG_INFINITY,unbounded.ub());
+          return unbounded;
+        });
     }
 
     if(t.is_empty() || z.is_empty() || y.is_empty())
@@ -8,14 +8,21 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <thread>
+#include <algorithm>
 #include "codac_CtcStatic.h"
+#include "codac_CtcFunction.h"
 #include "codac_DomainsTypeException.h"
+#include "codac_Exception.h"
+#include "codac_Tools.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  #define MIN_SLICES_PER_THREAD 64 // below, the contraction is not worth a thread
+
   CtcStatic::CtcStatic(Ctc& static_ctc, bool temporal_ctc)
     : DynCtc(temporal_ctc), m_static_ctc(static_ctc), m_temporal_ctc(temporal_ctc ? 1 : 0)
   {
@@ -146,6 +153,15 @@ namespace codac
 
   void CtcStatic::contract(Slice **v_x_slices, int n)
   {
+    if(!m_v_ctc_clones.empty())
+    {
+      vector<Ctc*> v_ctc(1, &m_static_ctc);
+      for(const auto& ctc : m_v_ctc_clones)
+        v_ctc.push_back(ctc.get());
+      contract_chunks(v_x_slices, n, v_ctc, m_temporal_ctc, m_restricted_tdomain);
+      return;
+    }
+
     IntervalVector envelope(n + m_temporal_ctc);
     IntervalVector ingate(n + m_temporal_ctc);
 
@@ -208,4 +224,126 @@ namespace codac
           v_x_slices[i] = v_x_slices[i]->next_slice();
     }
   }
+
+  void CtcStatic::set_nb_threads(int nb_threads, const function<Ctc*()>& ctc_factory)
+  {
+    assert(nb_threads >= 0 && "invalid number of threads");
+
+    if(nb_threads == 0)
+      nb_threads = std::max(1, (int)thread::hardware_concurrency());
+
+    const CtcFunction *ctc_f = dynamic_cast<const CtcFunction*>(&m_static_ctc);
+    if(nb_threads > 1 && !ctc_factory && !ctc_f)
+      throw Exception(__func__, "a factory of contractors is required for the parallel mode");
+
+    m_v_ctc_clones.clear();
+    for(int c = 1 ; c < nb_threads ; c++)
+    {
+      m_v_ctc_clones.push_back(unique_ptr<Ctc>(ctc_factory ? ctc_factory() : ctc_f->clone()));
+      assert(m_v_ctc_clones.back()->nb_var == m_static_ctc.nb_var);
+    }
+  }
+
+  int CtcStatic::nb_threads() const
+  {
+    return m_v_ctc_clones.size() + 1;
+  }
+
+  void CtcStatic::contract_chunks(Slice **v_x_slices, int n, const vector<Ctc*>& v_ctc,
+                                  int temporal_ctc, const Interval& restricted_tdomain)
+  {
+    assert(!v_ctc.empty());
+
+    // Slices are indexed for a direct access to each chunk
+    vector<vector<Slice*>> v_slices(n);
+    for(int i = 0 ; i < n ; i++)
+      for(Slice *s = v_x_slices[i] ; s ; s = s->next_slice())
+        v_slices[i].push_back(s);
+
+    const int nb_slices = v_slices[0].size();
+    for(int i = 1 ; i < n ; i++)
+    {
+      if((int)v_slices[i].size() != nb_slices)
+        throw Exception(__func__, "tubes must share the same slicing");
+      #ifndef NDEBUG
+        for(int k = 0 ; k < nb_slices ; k++)
+          assert(v_slices[i][k]->tdomain() == v_slices[0][k]->tdomain() && "tubes must share the same slicing");
+      #endif
+    }
+    const int nb_chunks = std::max(1, std::min((int)v_ctc.size(), nb_slices / MIN_SLICES_PER_THREAD));
+
+    vector<char> v_active(nb_slices); // char: concurrent writes on distinct elements
+    vector<IntervalVector> v_envelope(nb_slices, IntervalVector(n + temporal_ctc));
+    vector<IntervalVector> v_ingate(nb_slices, IntervalVector(n + temporal_ctc));
+    IntervalVector outgate(n + temporal_ctc);
+    vector<int> v_first(nb_chunks);
+
+    // Input gate of the slice k, as updated by the contraction of the slice k-1
+    auto ingate_box = [&](int k) -> IntervalVector&
+    {
+      IntervalVector& ingate = v_ingate[k];
+      if(temporal_ctc)
+        ingate[0] = v_slices[0][k]->tdomain().lb();
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        ingate[i+temporal_ctc] = v_slices[i][k]->input_gate();
+        if(k > 0 && v_active[k-1])
+          ingate[i+temporal_ctc] &= v_envelope[k-1][i+temporal_ctc];
+      }
+
+      return ingate;
+    };
+
+    Tools::parallel_chunks(nb_slices, nb_chunks, [&](int c, int begin, int end)
+    {
+      Ctc& ctc = *v_ctc[c];
+      v_first[c] = begin;
+
+      for(int k = begin ; k < end ; k++)
+      {
+        // If these slices should not be impacted by the contractor
+        v_active[k] = v_slices[0][k]->tdomain().intersects(restricted_tdomain);
+        if(!v_active[k])
+          continue;
+
+        IntervalVector& envelope = v_envelope[k];
+        if(temporal_ctc)
+          envelope[0] = v_slices[0][k]->tdomain();
+        for(int i = 0 ; i < n ; i++)
+          envelope[i+temporal_ctc] = v_slices[i][k]->codomain();
+        ctc.contract(envelope);
+
+        // The first input gate of a chunk depends on the previous chunk
+        if(k != begin || c == 0)
+          ctc.contract(ingate_box(k));
+
+        if(k == nb_slices-1) // output gate
+        {
+          if(temporal_ctc)
+            outgate[0] = v_slices[0][k]->tdomain().ub();
+          for(int i = 0 ; i < n ; i++)
+            outgate[i+temporal_ctc] = v_slices[i][k]->output_gate() & envelope[i+temporal_ctc];
+          ctc.contract(outgate);
+        }
+      }
+    });
+
+    // Reconciliation of the gates at the borders of the chunks
+    for(int c = 1 ; c < nb_chunks ; c++)
+      if(v_active[v_first[c]])
+        v_ctc[0]->contract(ingate_box(v_first[c]));
+
+    for(int k = 0 ; k < nb_slices ; k++)
+      if(v_active[k])
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_slices[i][k]->set_envelope(v_envelope[k][i+temporal_ctc]);
+          v_slices[i][k]->set_input_gate(v_ingate[k][i+temporal_ctc]);
+        }
+
+    if(nb_slices > 0 && v_active[nb_slices-1])
+      for(int i = 0 ; i < n ; i++)
+        v_slices[i][nb_slices-1]->set_output_gate(outgate[i+temporal_ctc]);
+  }
 }
\ No newline at end of file
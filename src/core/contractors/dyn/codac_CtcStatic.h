@@ -12,6 +12,9 @@
 #ifndef __CODAC_CTCSTATIC_H__
 #define __CODAC_CTCSTATIC_H__
 
+#include <vector>
+#include <memory>
+#include <functional>
 #include "codac_Ctc.h"
 #include "codac_DynCtc.h"
 #include "codac_Domain.h"
@@ -120,10 +123,51 @@ namespace codac
        */
       void contract(Slice **v_x_slices, int n);
 
+      /**
+       * \brief Enables the parallel contraction of the slices, by chunks of
+       *        slices processed simultaneously
+       *
+       * IBEX contractors are not reentrant: each additional thread works with its
+       * own contractor, equivalent to the one of this object. If the latter is a
+       * CtcFunction, it is cloned and no factory is required.
+       *
+       * \param nb_threads number of threads, 0 for the hardware concurrency, 1 for a sequential contraction
+       * \param ctc_factory function creating a new contractor equivalent to the one
+       *        of this object, owned by the CtcStatic afterwards. It is called sequentially,
+       *        `nb_threads-1` times, by the calling thread.
+       */
+      void set_nb_threads(int nb_threads, const std::function<Ctc*()>& ctc_factory = nullptr);
+
+      /**
+       * \brief Returns the number of threads used for the contraction of the slices
+       *
+       * \return number of threads
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Contracts an array of slices (representing a slice vector) with
+       *        several equivalent IBEX contractors working simultaneously on chunks of slices
+       *
+       * The contractors only read the slices: contracted boxes are stored, the input gates
+       * shared at the borders of the chunks are contracted afterwards, and the slices
+       * are updated in a final sequential pass. The result is the same as the one of
+       * a sequential contraction.
+       *
+       * \param v_x_slices the first slices to be contracted
+       * \param n the dimension of the array
+       * \param v_ctc the contractors, one per chunk, the first one being also used at the borders
+       * \param temporal_ctc 1 if the temporal tdomain is the first dimension of the boxes, 0 otherwise
+       * \param restricted_tdomain the slices out of this tdomain are not contracted
+       */
+      static void contract_chunks(Slice **v_x_slices, int n, const std::vector<Ctc*>& v_ctc,
+                                  int temporal_ctc, const Interval& restricted_tdomain = Interval::ALL_REALS);
+
     protected:
 
       Ctc& m_static_ctc; //!< related static contractor
       int m_temporal_ctc; //!< specifies either the temporal tdomain is part of the constraint or not
+      std::vector<std::unique_ptr<Ctc>> m_v_ctc_clones; //!< contractors of the additional threads
 
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
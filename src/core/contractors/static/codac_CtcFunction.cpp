@@ -8,7 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <thread>
+#include <algorithm>
 #include "codac_CtcFunction.h"
+#include "codac_CtcStatic.h"
 
 using namespace std;
 using namespace ibex;
@@ -21,7 +24,7 @@ namespace codac
     // todo: clean delete
   }
 
-  CtcFunction::CtcFunction(const Function& f, const Domain& y)
+  CtcFunction::CtcFunction(const Function& f, const ibex::Domain& y)
     : CtcFwdBwd(*new Function(f), y)
   {
     // todo: clean delete
@@ -214,6 +217,15 @@ namespace codac
 
   void CtcFunction::contract(Slice **v_x_slices)
   {
+    if(!m_v_clones.empty())
+    {
+      vector<Ctc*> v_ctc(1, this);
+      for(const auto& ctc : m_v_clones)
+        v_ctc.push_back(ctc.get());
+      CtcStatic::contract_chunks(v_x_slices, nb_var, v_ctc, 0);
+      return;
+    }
+
     IntervalVector envelope(nb_var);
     IntervalVector ingate(nb_var);
 
@@ -254,4 +266,26 @@ namespace codac
           v_x_slices[i] = v_x_slices[i]->next_slice();
     }
   }
-}
\ No newline at end of file
+
+  CtcFunction* CtcFunction::clone() const
+  {
+    return new CtcFunction(f, d);
+  }
+
+  void CtcFunction::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0 && "invalid number of threads");
+
+    if(nb_threads == 0)
+      nb_threads = std::max(1, (int)thread::hardware_concurrency());
+
+    m_v_clones.clear();
+    for(int c = 1 ; c < nb_threads ; c++)
+      m_v_clones.push_back(unique_ptr<CtcFunction>(clone()));
+  }
+
+  int CtcFunction::nb_threads() const
+  {
+    return m_v_clones.size() + 1;
+  }
+}
@@ -13,6 +13,8 @@
 #define __CODAC_CTCFUNCTION_H__
 
 #include <string>
+#include <vector>
+#include <memory>
 #include "codac_Function.h"
 #include "ibex_CtcFwdBwd.h"
 #include "ibex_Domain.h"
@@ -201,6 +203,33 @@ namespace codac
        * \param v_x_slices the slices to be contracted
        */
       void contract(Slice **v_x_slices);
+
+      /**
+       * \brief Creates an independent copy of this contractor, with its own
+       *        copy of the function, that can be used simultaneously by another thread
+       *
+       * \return a pointer to the new contractor, to be deleted by the caller
+       */
+      CtcFunction* clone() const;
+
+      /**
+       * \brief Enables the parallel contraction of the slices of tubes, by chunks
+       *        of slices processed simultaneously, see CtcStatic::contract_chunks()
+       *
+       * \param nb_threads number of threads, 0 for the hardware concurrency, 1 for a sequential contraction
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Returns the number of threads used for the contraction of the slices of tubes
+       *
+       * \return number of threads
+       */
+      int nb_threads() const;
+
+    protected:
+
+      std::vector<std::unique_ptr<CtcFunction>> m_v_clones; //!< contractors of the additional threads
   };
 }
 
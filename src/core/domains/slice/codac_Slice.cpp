@@ -11,12 +11,25 @@
 #include <iomanip>
 #include "codac_Slice.h"
 #include "codac_CtcDeriv.h"
+#include "codac_SlabAllocator.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace codac
 {
+  // Contiguous storage of slices and gates, see SlabAllocator
+
+  static SlabAllocator<Slice>& slice_allocator()
+  {
+    return SlabAllocator<Slice>::instance();
+  }
+
+  static SlabAllocator<Interval>& gate_allocator()
+  {
+    return SlabAllocator<Interval>::instance();
+  }
+
   // Public methods
 
     // Definition
@@ -25,8 +38,8 @@ namespace codac
       : m_tdomain(tdomain), m_codomain(codomain)
     {
       assert(valid_tdomain(tdomain));
-      m_input_gate = new Interval(codomain);
-      m_output_gate = new Interval(codomain);
+      m_input_gate = new_gate(codomain);
+      m_output_gate = new_gate(codomain);
     }
 
     Slice::Slice(const Slice& x)
@@ -42,8 +55,23 @@ namespace codac
       if(m_next_slice) m_next_slice->m_prev_slice = nullptr;
 
       // Gates are deleted if not shared with other slices
-      if(m_prev_slice == nullptr) delete m_input_gate;
-      if(m_next_slice == nullptr) delete m_output_gate;
+      if(m_prev_slice == nullptr) delete_gate(m_input_gate);
+      if(m_next_slice == nullptr) delete_gate(m_output_gate);
+    }
+
+    void* Slice::operator new(size_t size)
+    {
+      if(size != sizeof(Slice)) // derived classes
+        return ::operator new(size);
+      return slice_allocator().allocate();
+    }
+
+    void Slice::operator delete(void *ptr, size_t size)
+    {
+      if(size != sizeof(Slice))
+        ::operator delete(ptr);
+      else
+        slice_allocator().deallocate(ptr);
     }
 
     int Slice::size() const
@@ -53,6 +81,8 @@ namespace codac
 
     const Slice& Slice::operator=(const Slice& x)
     {
+      const double prev_volume = m_tube_reference ? tracked_volume() : 0.;
+
       m_tdomain = x.m_tdomain;
       m_codomain = x.m_codomain;
       *m_input_gate = *x.m_input_gate;
@@ -63,7 +93,8 @@ namespace codac
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
-      
+
+      update_tracked_volume(prev_volume);
       return *this;
     }
     
@@ -442,6 +473,7 @@ namespace codac
 
     void Slice::set(const Interval& y)
     {
+      const double prev_volume = m_tube_reference ? tracked_volume() : 0.;
       m_codomain = y;
 
       *m_input_gate = y;
@@ -457,6 +489,8 @@ namespace codac
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
+
+      update_tracked_volume(prev_volume);
     }
     
     void Slice::set_empty()
@@ -466,6 +500,7 @@ namespace codac
 
     void Slice::set_envelope(const Interval& envelope, bool slice_consistency)
     {
+      const double prev_volume = m_tube_reference ? tracked_volume() : 0.;
       m_codomain = envelope;
 
       if(slice_consistency)
@@ -479,10 +514,13 @@ namespace codac
         m_synthesis_reference->request_values_update();
         m_synthesis_reference->request_integrals_update();
       }
+
+      update_tracked_volume(prev_volume);
     }
 
     void Slice::set_input_gate(const Interval& input_gate, bool slice_consistency)
     {
+      const double prev_volume = m_tube_reference ? tracked_volume() : 0.;
       *m_input_gate = input_gate;
 
       if(slice_consistency)
@@ -497,10 +535,13 @@ namespace codac
         m_synthesis_reference->request_values_update();
         // Note: integrals are not impacted by gates
       }
+
+      update_tracked_volume(prev_volume);
     }
 
     void Slice::set_output_gate(const Interval& output_gate, bool slice_consistency)
     {
+      const double prev_volume = m_tube_reference ? tracked_volume() : 0.;
       *m_output_gate = output_gate;
 
       if(slice_consistency)
@@ -515,6 +556,8 @@ namespace codac
         m_synthesis_reference->request_values_update();
         // Note: integrals are not impacted by gates
       }
+
+      update_tracked_volume(prev_volume);
     }
     
     const Slice& Slice::inflate(double rad)
@@ -577,6 +620,20 @@ namespace codac
       }
     }
 
+    Interval* Slice::new_gate(const Interval& x)
+    {
+      return new(gate_allocator().allocate()) Interval(x);
+    }
+
+    void Slice::delete_gate(Interval *gate)
+    {
+      if(gate)
+      {
+        gate->~Interval();
+        gate_allocator().deallocate(gate);
+      }
+    }
+
     void Slice::merge_slices(Slice *first_slice, Slice *&second_slice)
     {
       assert(first_slice && second_slice);
@@ -590,7 +647,7 @@ namespace codac
       first_slice->set_tdomain(first_slice->tdomain() | second_slice->tdomain());
 
       // Deleting objects after fusion
-      first_slice->m_output_gate = new Interval(second_slice->output_gate());
+      first_slice->m_output_gate = new_gate(second_slice->output_gate());
 
       second_slice->m_prev_slice = nullptr;
       second_slice->m_next_slice = nullptr;
@@ -613,6 +670,32 @@ namespace codac
       return IntervalVector(m_codomain);
     }
 
+    // Volume tracking
+
+    double Slice::bounded_diam(const Interval& x)
+    {
+      if(x.is_empty())
+        return 0.;
+
+      else if(x.is_unbounded())
+        return 999999.; // same convention as for fixed point detection in CN
+
+      else
+        return x.diam();
+    }
+
+    double Slice::tracked_volume() const
+    {
+      return m_tdomain.diam() * bounded_diam(m_codomain)
+        + bounded_diam(*m_input_gate) + bounded_diam(*m_output_gate);
+    }
+
+    void Slice::update_tracked_volume(double prev_volume) const
+    {
+      if(m_tube_reference)
+        m_tube_reference->add_tracked_volume(tracked_volume() - prev_volume, m_tdomain);
+    }
+
     // Setting values
     
 }
\ No newline at end of file
@@ -59,6 +59,26 @@ namespace codac
        */
       ~Slice();
 
+      /**
+       * \brief Allocates memory for a Slice object
+       *
+       * Slices are served from contiguous chunks of memory shared by all the tubes:
+       * the slices of a tube created at once are stored next to each other,
+       * and their addresses are stable.
+       *
+       * \param size size of the object
+       * \return pointer to the allocated memory
+       */
+      static void* operator new(std::size_t size);
+
+      /**
+       * \brief Releases the memory of a Slice object
+       *
+       * \param ptr pointer to the object
+       * \param size size of the object
+       */
+      static void operator delete(void *ptr, std::size_t size);
+
       /**
        * \brief Returns the dimension of the slice (always 1)
        *
@@ -655,6 +675,21 @@ namespace codac
        */
       static void merge_slices(Slice *first_slice, Slice *&second_slice);
 
+      /**
+       * \brief Creates a gate, stored contiguously with the other gates
+       *
+       * \param x initial value of the gate
+       * \return a pointer to the new gate
+       */
+      static Interval* new_gate(const Interval& x);
+
+      /**
+       * \brief Destroys a gate created by new_gate()
+       *
+       * \param gate a pointer to the gate, may be `nullptr`
+       */
+      static void delete_gate(Interval *gate);
+
       /**
        * \brief Returns the box \f$\llbracket x\rrbracket([t_0,t_f])\f$
        *
@@ -664,6 +699,32 @@ namespace codac
        */
       const IntervalVector codomain_box() const;
 
+      /**
+       * \brief Returns the diameter of an interval, bounded for fixed point detection
+       *
+       * \param x the interval
+       * \return 0 if \f$[x]\f$ is empty, a large value if it is unbounded, its diameter otherwise
+       */
+      static double bounded_diam(const Interval& x);
+
+      /**
+       * \brief Returns the volume of the envelope and the gates of this slice,
+       *        as accounted in the tracked volume of the related tube
+       *
+       * \return the sum of the bounded volume of the envelope and the bounded diameters of the gates
+       */
+      double tracked_volume() const;
+
+      /**
+       * \brief Reports to the related tube the change of volume of this slice,
+       *        together with its temporal domain
+       *
+       * \note Has no effect if the volume of the tube is not tracked
+       *
+       * \param prev_volume tracked volume of the slice before its update
+       */
+      void update_tracked_volume(double prev_volume) const;
+
       // Class variables:
 
         Interval m_tdomain; //!< temporal domain \f$[t_0,t_f]\f$ of the slice
@@ -671,11 +732,17 @@ namespace codac
         Interval *m_input_gate = nullptr, *m_output_gate = nullptr; //!< input and output gates
         Slice *m_prev_slice = nullptr, *m_next_slice = nullptr; //!< pointers to previous and next slices of the related tube
         mutable TubeTreeSynthesis *m_synthesis_reference = nullptr; //!< pointer to a leaf of the optional synthesis tree of the related tube
+        mutable Tube *m_tube_reference = nullptr; //!< pointer to the related tube, if its volume is tracked
 
       friend class Tube;
       friend class TubeTreeSynthesis;
       friend class CtcEval;
+      friend class CtcDeriv;
+      friend class ContractorNetwork;
+      friend class Domain;
+      friend class TubeKernels;
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+      friend void deserialize_Tube(int nb_slices, const double *tdomains, const double *codomains, const double *gates, double timestep, Tube *&tube);
   };
 }
 
@@ -13,6 +13,7 @@
 #include "codac_CtcDeriv.h"
 #include "codac_CtcEval.h"
 #include "codac_serialize_trajectories.h"
+#include "codac_tube_kernels.h"
 #include "ibex_LargestFirst.h"
 #include "ibex_NoBisectableVariableException.h"
 
@@ -36,6 +37,7 @@ namespace codac
 
       // By default, the tube is defined as one single slice
       m_first_slice = new Slice(tdomain, codomain);
+      m_timestep = tdomain.diam();
       
       // Redundant information for fast access
       m_tdomain = tdomain;
@@ -54,6 +56,7 @@ namespace codac
 
       if(timestep == 0.)
         timestep = tdomain.diam();
+      m_timestep = timestep; // uniform slicing
 
       do
       {
@@ -64,7 +67,7 @@ namespace codac
 
         if(prev_slice)
         {
-          delete slice->m_input_gate;
+          Slice::delete_gate(slice->m_input_gate);
           slice->m_input_gate = nullptr;
           Slice::chain_slices(prev_slice, slice);
         }
@@ -209,6 +212,7 @@ namespace codac
 
         delete_synthesis_tree();
         delete_polynomial_synthesis();
+        invalidate_time_index();
       
       // Creating new structure
 
@@ -230,7 +234,7 @@ namespace codac
 
           if(prev_slice)
           {
-            delete slice->m_input_gate;
+            Slice::delete_gate(slice->m_input_gate);
             slice->m_input_gate = nullptr;
             Slice::chain_slices(prev_slice, slice);
           }
@@ -240,6 +244,8 @@ namespace codac
 
         // Redundant information for fast access
         m_tdomain = x.tdomain();
+        m_timestep = x.m_timestep;
+        m_tracked_volume_valid = false;
 
       return *this;
     }
@@ -318,16 +324,13 @@ namespace codac
 
     int Tube::nb_slices() const
     {
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->nb_slices();
-      
-      else
-      {
-        int size = 0;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-          size ++;
-        return size;
-      }
+      update_time_index();
+      return m_v_slices.size();
+    }
+
+    double Tube::timestep() const
+    {
+      return m_timestep;
     }
 
     Slice* Tube::slice(int slice_id)
@@ -337,25 +340,12 @@ namespace codac
 
     const Slice* Tube::slice(int slice_id) const
     {
-      if(slice_id < 0 && slice_id >= nb_slices())
-        return nullptr;
-
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast access
-        return m_synthesis_tree->slice(slice_id);
-      
-      else
-      {
-        int i = 0;
-
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          if(i == slice_id)
-            return s;
-          i++;
-        }
+      update_time_index();
 
+      if(slice_id < 0 || slice_id >= (int)m_v_slices.size())
         return nullptr;
-      }
+
+      return m_v_slices[slice_id];
     }
 
     Slice* Tube::slice(double t)
@@ -368,22 +358,7 @@ namespace codac
       if(!tdomain().contains(t))
         return nullptr;
 
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->slice(t);
-      
-      else
-      {
-        const Slice *last_s = nullptr;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          if(t < s->tdomain().ub())
-            return s;
-          last_s = s;
-        }
-        
-        assert(last_s);
-        return last_s;
-      }
+      return m_v_slices[time_to_index(t)];
     }
 
     Slice* Tube::first_slice()
@@ -403,16 +378,8 @@ namespace codac
 
     const Slice* Tube::last_slice() const
     {
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->slice(nb_slices() - 1);
-      
-      else
-      {
-        for(const Slice *s = first_slice() ; true ; s = s->next_slice())
-          if(s->next_slice() == nullptr)
-            return s;
-        return nullptr;
-      }
+      update_time_index();
+      return m_v_slices.empty() ? nullptr : m_v_slices.back();
     }
 
     Slice* Tube::wider_slice()
@@ -491,35 +458,40 @@ namespace codac
     int Tube::time_to_index(double t) const
     {
       assert(tdomain().contains(t));
+      update_time_index();
 
-      if(m_synthesis_mode == SynthesisMode::BINARY_TREE) // fast evaluation
-        return m_synthesis_tree->time_to_index(t);
-      
-      else
+      if(m_timestep > 0.) // uniform slicing: direct computation
       {
-        int i = -1;
-        for(const Slice *s = first_slice() ; s ; s = s->next_slice())
-        {
-          i++;
-          if(t < s->tdomain().ub())
-            return i;
-        }
-
+        const int n = m_v_slices_ub.size();
+        int i = std::min(n-1, (int)((t - m_tdomain.lb()) / m_timestep));
+        // Correction of floating-point errors around the gates
+        while(i < n-1 && t >= m_v_slices_ub[i]) i++;
+        while(i > 0 && t < m_v_slices_ub[i-1]) i--;
         return i;
       }
+
+      // First slice such that t < ub, or the last one
+      vector<double>::const_iterator it = upper_bound(m_v_slices_ub.begin(), m_v_slices_ub.end(), t);
+      if(it == m_v_slices_ub.end())
+        return m_v_slices_ub.size() - 1;
+      return it - m_v_slices_ub.begin();
     }
 
     int Tube::index(const Slice* slice) const
     {
-      int i = 0;
-      const Slice *it = first_slice();
-      while(it && it != slice)
-      {
-        it = it->next_slice();
-        if(it == nullptr) return -1;
-        i++;
-      }
-      return i;
+      assert(slice);
+      if(!tdomain().contains(slice->tdomain().lb()))
+        return -1;
+
+      const int i = time_to_index(slice->tdomain().lb());
+      if(m_v_slices[i] == slice)
+        return i;
+
+      // Degenerate slices may share the same lower bound
+      for(int j = 0 ; j < (int)m_v_slices.size() ; j++)
+        if(m_v_slices[j] == slice)
+          return j;
+      return -1;
     }
 
     void Tube::sample(double t)
@@ -548,6 +520,13 @@ namespace codac
         delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
 
         Slice *next_slice = slice_to_be_sampled->next_slice();
+        const Interval sampled_tdomain = slice_to_be_sampled->tdomain();
+        const double prev_volume = m_tracked_volume_valid ? slice_to_be_sampled->tracked_volume() : 0.;
+        m_timestep = 0.; // the slicing is not uniform anymore
+
+        // Index of the slice in the time index, if up to date
+        const int slice_id = m_time_index_valid ? time_to_index(t) : -1;
+        assert(slice_id == -1 || m_v_slices[slice_id] == slice_to_be_sampled);
 
         // Creating new slice
         Slice *new_slice = new Slice(*slice_to_be_sampled);
@@ -555,11 +534,25 @@ namespace codac
         slice_to_be_sampled->set_tdomain(Interval(slice_to_be_sampled->tdomain().lb(), t));
 
         // Updated slices structure
-        delete new_slice->m_input_gate;
+        Slice::delete_gate(new_slice->m_input_gate);
         new_slice->m_input_gate = nullptr;
         Slice::chain_slices(new_slice, next_slice);
         Slice::chain_slices(slice_to_be_sampled, new_slice);
         new_slice->set_input_gate(new_slice->codomain());
+
+        if(slice_id != -1) // the time index is updated without full computation
+        {
+          m_v_slices.insert(m_v_slices.begin() + slice_id + 1, new_slice);
+          m_v_slices_ub.insert(m_v_slices_ub.begin() + slice_id, t);
+        }
+
+        if(m_tracked_volume_valid) // the tracked volume is updated without full computation
+        {
+          new_slice->m_tube_reference = this;
+          add_tracked_volume(slice_to_be_sampled->tracked_volume() + new_slice->tracked_volume()
+            - Slice::bounded_diam(new_slice->input_gate()) // shared gate
+            - prev_volume, sampled_tdomain);
+        }
       }
     }
 
@@ -596,11 +589,30 @@ namespace codac
       assert(tdomain().contains(t));
       assert(t != tdomain().lb() && t != tdomain().ub() && "cannot remove initial/final gates");
 
-      Slice *s2 = slice(t);
+      const int s2_id = time_to_index(t);
+      Slice *s2 = m_v_slices[s2_id];
       assert(s2->tdomain().lb() == t && "the gate must already exist");
       Slice *s1 = s2->prev_slice();
 
-      Slice::merge_slices(s1, s2);
+      // The time index is updated without full computation
+      m_v_slices.erase(m_v_slices.begin() + s2_id);
+      m_timestep = 0.;
+      m_v_slices_ub.erase(m_v_slices_ub.begin() + s2_id - 1);
+
+      if(m_tracked_volume_valid) // the tracked volume is updated without full computation
+      {
+        const Interval merged_tdomain = s1->tdomain() | s2->tdomain();
+        const double prev_volume = s1->tracked_volume() + s2->tracked_volume()
+          - Slice::bounded_diam(s2->input_gate()); // shared gate
+
+        s1->m_tube_reference = nullptr; // changes are reported once merged
+        Slice::merge_slices(s1, s2);
+        s1->m_tube_reference = this;
+        add_tracked_volume(s1->tracked_volume() - prev_volume, merged_tdomain);
+      }
+
+      else
+        Slice::merge_slices(s1, s2);
     }
 
     void Tube::merge_similar_slices(double distance_threshold)
@@ -612,10 +624,16 @@ namespace codac
         Slice *next_slice = s2->next_slice();
 
         if(s1 && distance(s1->codomain(),s2->codomain()) < distance_threshold)
-            Slice::merge_slices(s1, s2);
+        {
+          Slice::merge_slices(s1, s2);
+          m_timestep = 0.;
+        }
       
         s2 = next_slice;
       }
+
+      m_tracked_volume_valid = false;
+      invalidate_time_index();
     }
 
     // Accessing values
@@ -637,6 +655,60 @@ namespace codac
       return volume;
     }
 
+    double Tube::tracked_volume() const
+    {
+      if(!m_tracked_volume_valid.load(memory_order_acquire))
+      {
+        lock_guard<mutex> lock(m_time_index_mutex);
+        if(!m_tracked_volume_valid.load(memory_order_relaxed)) // not computed by another thread in the meantime
+        {
+          // Full computation, slices are then in charge of reporting their changes
+          double volume = Slice::bounded_diam(first_slice()->input_gate());
+          for(const Slice *s = first_slice() ; s ; s = s->next_slice())
+          {
+            s->m_tube_reference = const_cast<Tube*>(this);
+            volume += s->m_tdomain.diam() * Slice::bounded_diam(s->m_codomain)
+              + Slice::bounded_diam(*s->m_output_gate);
+          }
+
+          m_tracked_volume = volume;
+
+          // Changes are not known beforehand
+          m_changed_t_lb = tdomain().lb();
+          m_changed_t_ub = tdomain().ub();
+
+          m_tracked_volume_valid.store(true, memory_order_release);
+        }
+      }
+
+      return m_tracked_volume;
+    }
+
+    const Interval Tube::changed_tdomain() const
+    {
+      if(!m_tracked_volume_valid)
+        return tdomain();
+
+      double lb = m_changed_t_lb, ub = m_changed_t_ub;
+      if(lb > ub)
+        return Interval::EMPTY_SET;
+      return Interval(lb, ub);
+    }
+
+    const Interval Tube::changed_tdomain(uint64_t window_id) const
+    {
+      if(window_id != m_changed_window_id)
+        return tdomain(); // reset by another consumer
+      return changed_tdomain();
+    }
+
+    uint64_t Tube::reset_changed_tdomain()
+    {
+      m_changed_t_lb = POS_INFINITY;
+      m_changed_t_ub = NEG_INFINITY;
+      return ++m_changed_window_id;
+    }
+
     const Interval Tube::operator()(int slice_id) const
     {
       assert(slice_id >= 0 && slice_id < nb_slices());
@@ -1202,21 +1274,7 @@ namespace codac
     {
       assert(rad >= 0.);
       Interval e(-rad,rad);
-
-      Slice *s = nullptr;
-      do
-      {
-        if(s == nullptr) // first iteration
-          s = first_slice();
-        else
-          s = s->next_slice();
-
-        s->set_envelope(s->codomain() + e, false);
-        s->set_input_gate(s->input_gate() + e, false);
-
-      } while(s->next_slice());
-
-      s->set_output_gate(s->output_gate() + e, false);
+      TubeKernels::map(*this, [&e](const Interval& v) { return v + e; });
       return *this;
     }
 
@@ -1259,6 +1317,7 @@ namespace codac
       }
 
       m_first_slice->set_tdomain(t & m_first_slice->tdomain());
+      invalidate_time_index(); // first slices have been removed
 
       // After this iteration, the last slice will be the one containing t.ub()
       Slice *s_last = last_slice();
@@ -1272,6 +1331,9 @@ namespace codac
       s_last->set_tdomain(t & s_last->tdomain());
 
       m_tdomain = t;
+      m_timestep = 0.; // the first slice may have been truncated
+      m_tracked_volume_valid = false;
+      invalidate_time_index(); // slices have been removed
       delete_synthesis_tree(); // todo: update tree if created, instead of delete
       delete_polynomial_synthesis(); // todo: update tree if created, instead of delete
       return *this;
@@ -1282,6 +1344,8 @@ namespace codac
       for(Slice *s = first_slice() ; s ; s = s->next_slice())
         s->shift_tdomain(shift_ref);
       m_tdomain += shift_ref;
+      m_timestep = 0.; // shifted bounds may not match a grid computed from the new t0
+      invalidate_time_index();
       delete_synthesis_tree();
       delete_polynomial_synthesis();
     }
@@ -1489,6 +1553,9 @@ namespace codac
     
     bool Tube::same_slicing(const Tube& x1, const Tube& x2)
     {
+      if(x1.m_timestep > 0. && x1.m_timestep == x2.m_timestep && x1.m_tdomain == x2.m_tdomain)
+        return true; // same uniform slicing, computed the same way
+
       if(x1.nb_slices() != x2.nb_slices())
         return false;
 
@@ -1609,6 +1676,45 @@ namespace codac
       m_synthesis_mode = SynthesisMode::BINARY_TREE;
     }
     
+    void Tube::add_tracked_volume(double dv, const Interval& tdomain) const
+    {
+      if(dv == 0.)
+        return;
+
+      double volume = m_tracked_volume.load();
+      while(!m_tracked_volume.compare_exchange_weak(volume, volume + dv));
+
+      double lb = m_changed_t_lb.load();
+      while(tdomain.lb() < lb && !m_changed_t_lb.compare_exchange_weak(lb, tdomain.lb()));
+      double ub = m_changed_t_ub.load();
+      while(tdomain.ub() > ub && !m_changed_t_ub.compare_exchange_weak(ub, tdomain.ub()));
+    }
+
+    void Tube::update_time_index() const
+    {
+      if(m_time_index_valid.load(memory_order_acquire))
+        return;
+
+      lock_guard<mutex> lock(m_time_index_mutex);
+      if(m_time_index_valid.load(memory_order_relaxed))
+        return; // built by another thread in the meantime
+
+      m_v_slices.clear();
+      m_v_slices_ub.clear();
+      for(const Slice *s = first_slice() ; s ; s = s->next_slice())
+      {
+        m_v_slices.push_back(const_cast<Slice*>(s));
+        m_v_slices_ub.push_back(s->tdomain().ub());
+      }
+
+      m_time_index_valid.store(true, memory_order_release);
+    }
+
+    void Tube::invalidate_time_index() const
+    {
+      m_time_index_valid = false;
+    }
+
     void Tube::delete_synthesis_tree() const
     {
       if(m_synthesis_mode == SynthesisMode::BINARY_TREE)
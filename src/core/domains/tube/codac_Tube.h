@@ -15,6 +15,9 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include "codac_TFnc.h"
 #include "codac_Slice.h"
 #include "codac_Trajectory.h"
@@ -236,6 +239,18 @@ namespace codac
        */
       int nb_slices() const;
 
+      /**
+       * \brief Returns the timestep of this tube, if its slices are uniformly distributed
+       *
+       * \note The tdomains of the slices are then \f$[t_0+k\delta,t_0+(k+1)\delta]\f$,
+       *       the last one being possibly smaller. Slice indexes are computed in
+       *       constant time. The timestep is lost when the tube is sampled at a time
+       *       that is not on the grid, or when its tdomain is modified.
+       *
+       * \return the timestep \f$\delta\f$, or \f$0\f$ for a non-uniform slicing
+       */
+      double timestep() const;
+
       /**
        * \brief Returns a pointer to the ith Slice object of this tube
        *
@@ -468,6 +483,52 @@ namespace codac
        */
       double volume() const;
 
+      /**
+       * \brief Returns the volume of this tube together with the diameters of its gates,
+       *        as used for fixed point detection in contractor networks
+       *
+       * The first call is linear in the number of slices. The value is then kept up to date
+       * by the slices each time they are contracted, so that next calls are in constant time,
+       * until the structure of the tube changes (sampling, truncation, etc.).
+       *
+       * \note Unbounded envelopes or gates are accounted with a large bounded value
+       *
+       * \return the tracked volume
+       */
+      double tracked_volume() const;
+
+      /**
+       * \brief Returns the hull of the temporal domains of the slices that have been
+       *        contracted since the last call to reset_changed_tdomain()
+       *
+       * \note The whole temporal domain is returned if the volume of the tube is not
+       *       tracked, see tracked_volume()
+       *
+       * \return the temporal window of the last changes, possibly empty
+       */
+      const Interval changed_tdomain() const;
+
+      /**
+       * \brief Returns the temporal window of the changes since a given reset
+       *
+       * Several consumers of the changes (for instance networks sharing this tube)
+       * can use this method: if another consumer has reset the window in the
+       * meantime, the changes are not known anymore and the whole temporal
+       * domain is returned.
+       *
+       * \param window_id identifier returned by the last reset_changed_tdomain() of the consumer,
+       *        or 0 if the consumer has never reset the window
+       * \return the temporal window of the changes, possibly empty
+       */
+      const Interval changed_tdomain(std::uint64_t window_id) const;
+
+      /**
+       * \brief Forgets the previous changes of the tube, see changed_tdomain()
+       *
+       * \return the identifier of the new window of changes (never 0)
+       */
+      std::uint64_t reset_changed_tdomain();
+
       /**
        * \brief Returns the value of the ith slice
        *
@@ -1136,6 +1197,8 @@ namespace codac
        * \note If true, it means the two tubes are defined with the same
        *       amount of slices and identical sampling
        *
+       * \note Constant time for two tubes of same tdomain and same timestep()
+       *
        * \param x1 the first Tube
        * \param x2 the second Tube
        * \return true in case of same slicing
@@ -1201,6 +1264,18 @@ namespace codac
        */
       void delete_synthesis_tree() const;
 
+      /**
+       * \brief Builds the time index of the slices, if it is not up to date
+       *
+       * \note Thread-safe, may be called from concurrent const accesses
+       */
+      void update_time_index() const;
+
+      /**
+       * \brief Marks the time index as out of date, after a change of the slices structure
+       */
+      void invalidate_time_index() const;
+
       /**
        * \brief Creates the synthesis tree associated to the values of this tube
        *
@@ -1215,6 +1290,16 @@ namespace codac
        */
       void delete_polynomial_synthesis() const;
 
+      /**
+       * \brief Adds a volume change reported by one of the slices of this tube
+       *
+       * \note Thread-safe, slices of a same tube may be contracted simultaneously
+       *
+       * \param dv the volume difference
+       * \param tdomain temporal domain of the change
+       */
+      void add_tracked_volume(double dv, const Interval& tdomain) const;
+
       // Class variables:
 
         Slice *m_first_slice = nullptr; //!< pointer to the first Slice object of this tube
@@ -1222,11 +1307,23 @@ namespace codac
         mutable TubePolynomialSynthesis *m_polynomial_synthesis = nullptr; //!< pointer to the optional synthesis tree
         mutable SynthesisMode m_synthesis_mode = SynthesisMode::NONE; //!< enables of the use of a synthesis tree
         Interval m_tdomain; //!< redundant information for fast evaluations
+        mutable std::atomic<double> m_tracked_volume{0.}; //!< volume incrementally updated by the slices
+        mutable std::atomic<bool> m_tracked_volume_valid{false}; //!< false if the tracked volume has to be computed again
+        mutable std::atomic<double> m_changed_t_lb{POS_INFINITY}, m_changed_t_ub{NEG_INFINITY}; //!< bounds of the window of the last changes
+        std::atomic<std::uint64_t> m_changed_window_id{1}; //!< identifier of the window of the last changes, incremented at each reset
+        mutable std::vector<Slice*> m_v_slices; //!< time index: pointers to the slices, in temporal order
+        mutable std::vector<double> m_v_slices_ub; //!< time index: upper bounds of the tdomains of the slices
+        mutable std::atomic<bool> m_time_index_valid{false}; //!< false if the time index has to be built again
+        mutable std::mutex m_time_index_mutex; //!< protection of the lazy builds of the time index and of the tracked volume
+        double m_timestep = 0.; //!< timestep of a uniform slicing, or 0 if the slicing is not uniform
 
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+      friend void deserialize_Tube(int nb_slices, const double *tdomains, const double *codomains, const double *gates, double timestep, Tube *&tube);
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
       friend class TubeVector;
       friend class CtcEval;
+      friend class Slice;
+      friend class TubeKernels;
 
       static bool s_enable_syntheses;
   };
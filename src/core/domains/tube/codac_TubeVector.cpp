@@ -71,9 +71,8 @@ namespace codac
       assert(valid_tdomain(tdomain));
       assert(f.nb_var() == 0 && "function's inputs must be limited to system variable");
 
-      // A copy of this is sent anyway in order to know the data structure to produce
-      TubeVector input(*this);
-      *this = f.eval_vector(input);
+      // This is sent anyway in order to know the data structure to produce
+      *this = f.eval_vector(*this);
     }
 
     TubeVector::TubeVector(const std::vector<Interval>& v_tdomains, const std::vector<IntervalVector>& v_codomains)
@@ -284,6 +283,15 @@ namespace codac
       return n;
     }
 
+    double TubeVector::timestep() const
+    {
+      double dt = (*this)[0].timestep();
+      for(int i = 1 ; i < size() && dt != 0. ; i++)
+        if((*this)[i].timestep() != dt)
+          dt = 0.;
+      return dt;
+    }
+
     int TubeVector::time_to_index(double t) const
     {
       assert(tdomain().contains(t));
@@ -618,7 +626,7 @@ namespace codac
       Trajectory diag_traj;
       TrajectoryVector diams = diam(gates_thicknesses);
 
-      for(map<double,double>::const_iterator it = diams[0].sampled_map().begin() ; it != diams[0].sampled_map().end() ; it++)
+      for(TrajectorySamples::const_iterator it = diams[0].samples().begin() ; it != diams[0].samples().end() ; it++)
       {
         double diag = 0.;
         for(int i = start_index ; i <= end_index ; i++)
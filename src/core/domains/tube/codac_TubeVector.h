@@ -282,6 +282,16 @@ namespace codac
        */
       int nb_slices() const;
 
+      /**
+       * \brief Returns the timestep shared by the components, if their slices are uniformly distributed
+       *
+       * \note See Tube::timestep()
+       *
+       * \return the timestep \f$\delta\f$, or \f$0\f$ if one of the components has a non-uniform
+       *         slicing or if the timesteps of the components differ
+       */
+      double timestep() const;
+
       /**
        * \brief Returns the Slice index related to the temporal key \f$t\f$
        *
@@ -10,6 +10,7 @@
 
 #include "codac_Tube.h"
 #include "codac_Trajectory.h"
+#include "codac_tube_kernels.h"
 
 using namespace std;
 using namespace ibex;
@@ -20,20 +21,7 @@ namespace codac
     \
     const Tube& Tube::f(const Interval& x) \
     { \
-      Slice *s = nullptr; \
-      do \
-      { \
-        if(s == nullptr) /* first iteration */ \
-          s = first_slice(); \
-        else \
-          s = s->next_slice(); \
-        \
-        s->set_envelope(Interval(s->codomain()).f(x), false); \
-        s->set_input_gate(Interval(s->input_gate()).f(x), false); \
-        \
-      } while(s->next_slice()); \
-      \
-      s->set_output_gate(Interval(s->output_gate()).f(x), false); \
+      TubeKernels::map(*this, [&x](const Interval& v) { return Interval(v).f(x); }); \
       return *this; \
     } \
     \
@@ -63,29 +51,7 @@ namespace codac
       assert(tdomain() == x.tdomain()); \
       \
       if(Tube::same_slicing(*this, x)) /* faster */ \
-      { \
-        Slice *s = nullptr; \
-        const Slice *s_x = nullptr; \
-        do \
-        { \
-          if(s == nullptr) /* first iteration */ \
-          { \
-            s = first_slice(); \
-            s_x = x.first_slice(); \
-          } \
-          \
-          else \
-          {  \
-            s = s->next_slice(); \
-            s_x = s_x->next_slice(); \
-          } \
-          \
-          s->set_envelope(Interval(s->codomain()).f(s_x->codomain()), false); \
-          s->set_input_gate(Interval(s->input_gate()).f(s_x->input_gate()), false); \
-        } while(s->next_slice()); \
-        \
-        s->set_output_gate(Interval(s->output_gate()).f((s_x->output_gate())), false); \
-      } \
+        TubeKernels::map(*this, x, [](const Interval& v, const Interval& v_x) { return Interval(v).f(v_x); }); \
       \
       else \
       { \
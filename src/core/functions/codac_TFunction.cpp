@@ -10,6 +10,9 @@
 
 #include <string>
 #include <sstream>
+#include <memory>
+#include <thread>
+#include <algorithm>
 #include "codac_TFunction.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
@@ -21,6 +24,8 @@ using namespace ibex;
 
 namespace codac
 {
+  #define MIN_SLICES_PER_THREAD 256 // below, the evaluation is not worth a thread
+
   std::string to_string(const Function& f)
   {
     stringstream s;
@@ -150,6 +155,7 @@ namespace codac
       delete m_ibex_f;
     m_ibex_f = new Function(*f.m_ibex_f);
     m_expr = f.m_expr;
+    m_nb_threads = f.m_nb_threads;
     TFnc::operator=(f);
     return *this;
   }
@@ -353,8 +359,7 @@ namespace codac
     if(nb_var() != 0)
       assert(x.size() == nb_var());
     
-    TubeVector y(x); // keeping slicing the x
-    y.resize(image_dim());
+    TubeVector y(image_dim(), x[0]); // keeping slicing the x
 
     if(x.is_empty())
     {
@@ -362,60 +367,87 @@ namespace codac
       return y;
     }
 
-    IntervalVector box(x.size() + 1), result(y.size());
+    // The slices are indexed before the parallel section: threads only read
+    // the slices of x, and the results are set in y by this thread only, the
+    // setters of the slices updating shared data (tracked volume, synthesis)
+    const int n = x.nb_slices();
+    vector<Interval> v_tdomains(n);
+    vector<vector<const Slice*>> v_x_slices(nb_var(), vector<const Slice*>(n));
+    int k = 0;
+    for(const Slice *s = y[0].first_slice() ; s ; s = s->next_slice())
+      v_tdomains[k++] = s->tdomain();
+    for(int i = 0 ; i < nb_var() ; i++)
+    {
+      k = 0;
+      for(const Slice *s = x[i].first_slice() ; s ; s = s->next_slice())
+        v_x_slices[i][k++] = s;
+    }
 
-    const Slice **v_sx = new const Slice*[x.size()];
-    for(int i = 0 ; i < x.size() ; i++)
-      v_sx[i] = nullptr;
+    vector<IntervalVector> v_envelope(n, IntervalVector(image_dim()));
+    vector<IntervalVector> v_ingate(n, IntervalVector(image_dim()));
+    IntervalVector outgate(image_dim());
 
-    Slice **v_sy = new Slice*[y.size()];
-    for(int i = 0 ; i < y.size() ; i++)
-      v_sy[i] = nullptr;
+    // Slices are evaluated by chunks, each thread with its own copy of the
+    // IBEX function (evaluations are not reentrant)
+    const int nb_chunks = std::max(1, std::min(m_nb_threads, n / MIN_SLICES_PER_THREAD));
+    vector<unique_ptr<Function>> v_f;
+    for(int c = 1 ; c < nb_chunks ; c++)
+      v_f.push_back(unique_ptr<Function>(new Function(*m_ibex_f)));
 
-    do
+    Tools::parallel_chunks(n, nb_chunks, [&](int c, int begin, int end)
     {
-      if(v_sx[0] == nullptr) // first iteration
-      {
-        for(int i = 0 ; i < x.size() ; i++)
-          v_sx[i] = x[i].first_slice();
-        for(int i = 0 ; i < y.size() ; i++)
-          v_sy[i] = y[i].first_slice();
-      }
+      eval_slices(c == 0 ? *m_ibex_f : *v_f[c-1], v_tdomains, v_x_slices, begin, end,
+                  v_envelope, v_ingate, outgate);
+    });
 
-      else
+    for(int i = 0 ; i < y.size() ; i++)
+    {
+      k = 0;
+      for(Slice *s = y[i].first_slice() ; s ; s = s->next_slice(), k++)
       {
-        for(int i = 0 ; i < x.size() ; i++)
-          v_sx[i] = v_sx[i]->next_slice();
-        for(int i = 0 ; i < y.size() ; i++)
-          v_sy[i] = v_sy[i]->next_slice();
+        s->set_envelope(v_envelope[k][i], false);
+        s->set_input_gate(v_ingate[k][i], false);
+        if(!s->next_slice())
+          s->set_output_gate(outgate[i], false);
       }
+    }
 
-      box[0] = v_sx[0]->tdomain();
-      for(int i = 0 ; i < x.size() ; i++)
-        box[i+1] = v_sx[i]->codomain();
-      result = m_ibex_f->eval_vector(box);
-      for(int i = 0 ; i < y.size() ; i++)
-        v_sy[i]->set_envelope(result[i], false);
+    return y;
+  }
 
-      box[0] = box[0].lb();
-      for(int i = 0 ; i < x.size() ; i++)
-        box[i+1] = v_sx[i]->input_gate();
-      result = m_ibex_f->eval_vector(box);
-      for(int i = 0 ; i < y.size() ; i++)
-        v_sy[i]->set_input_gate(result[i], false);
+  void TFunction::eval_slices(const Function& f, const vector<Interval>& v_tdomains,
+                              const vector<vector<const Slice*>>& v_x_slices, int begin, int end,
+                              vector<IntervalVector>& v_envelope, vector<IntervalVector>& v_ingate,
+                              IntervalVector& outgate) const
+  {
+    // The system variable t is the first argument
+    IntervalVector box(nb_var() + 1);
+    const int n = v_tdomains.size();
 
-    } while(v_sx[0]->next_slice());
-    
-    box[0] = v_sx[0]->tdomain().ub();
-    for(int i = 0 ; i < x.size() ; i++)
-      box[i+1] = v_sx[i]->output_gate();
-    result = m_ibex_f->eval_vector(box);
-    for(int i = 0 ; i < y.size() ; i++)
-      v_sy[i]->set_output_gate(result[i], false);
+    for(int k = begin ; k < end ; k++)
+    {
+      const Interval& t = v_tdomains[k];
 
-    delete[] v_sx;
-    delete[] v_sy;
-    return y;
+      box[0] = t;
+      for(int i = 0 ; i < nb_var() ; i++)
+        box[i+1] = v_x_slices[i][k]->codomain();
+      v_envelope[k] = f.eval_vector(box);
+
+      // Input gates only, except for the last slice:
+      // other output gates are input gates of the next slices
+      box[0] = t.lb();
+      for(int i = 0 ; i < nb_var() ; i++)
+        box[i+1] = v_x_slices[i][k]->input_gate();
+      v_ingate[k] = f.eval_vector(box);
+
+      if(k == n-1)
+      {
+        box[0] = t.ub();
+        for(int i = 0 ; i < nb_var() ; i++)
+          box[i+1] = v_x_slices[i][k]->output_gate();
+        outgate = f.eval_vector(box);
+      }
+    }
   }
 
   const IntervalVector TFunction::eval_vector(const IntervalVector& x1, const IntervalVector& x2) const
@@ -438,15 +470,39 @@ namespace codac
     assert(x[0].definition_type() == TrajDefnType::MAP_OF_VALUES
       && "eval TFunction not supported for analytic trajectories");
     
+    // The components are read along the time keys of x[0]: values of common
+    // keys are accessed directly, other ones are interpolated
+    vector<TrajectorySamples::const_iterator> v_it(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+      if(x[i].definition_type() == TrajDefnType::MAP_OF_VALUES)
+        v_it[i] = x[i].samples().begin();
+
     TrajectoryVector y(image_dim());
-    for(map<double,double>::const_iterator it = x[0].sampled_map().begin() ;
-        it != x[0].sampled_map().end() ; it++)
+    Vector v(nb_var() + 1);
+
+    for(const auto& it : x[0].samples())
     {
-      Vector v(nb_var() + 1);
-      v[0] = it->first;
-      v.put(1, x(it->first));
+      v[0] = it.first;
 
-      y.set(m_ibex_f->eval_vector(v).mid(), it->first);
+      for(int i = 0 ; i < x.size() ; i++)
+      {
+        if(x[i].definition_type() == TrajDefnType::MAP_OF_VALUES)
+        {
+          const TrajectorySamples& xi = x[i].samples();
+          while(v_it[i] != xi.end() && v_it[i]->first < it.first)
+            v_it[i]++;
+
+          if(v_it[i] != xi.end() && v_it[i]->first == it.first)
+          {
+            v[i+1] = v_it[i]->second;
+            continue;
+          }
+        }
+
+        v[i+1] = x[i](it.first);
+      }
+
+      y.set(m_ibex_f->eval_vector(v).mid(), it.first);
     }
 
     return y;
@@ -459,4 +515,18 @@ namespace codac
     diff_f.m_ibex_f = new Function(m_ibex_f->diff());
     return diff_f;
   }
+
+  void TFunction::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0 && "invalid number of threads");
+
+    if(nb_threads == 0)
+      nb_threads = std::max(1, (int)thread::hardware_concurrency());
+    m_nb_threads = nb_threads;
+  }
+
+  int TFunction::nb_threads() const
+  {
+    return m_nb_threads;
+  }
 }
\ No newline at end of file
@@ -82,12 +82,21 @@ namespace codac
 
       const TFunction diff() const;
 
+      // Number of threads for the evaluations on tubes, 0 for the hardware concurrency
+      void set_nb_threads(int nb_threads);
+      int nb_threads() const;
+
     protected:
 
       void construct_from_array(int n, const char** x, const char* y);
+      void eval_slices(const Function& f, const std::vector<Interval>& v_tdomains,
+                       const std::vector<std::vector<const Slice*>>& v_x_slices, int begin, int end,
+                       std::vector<IntervalVector>& v_envelope, std::vector<IntervalVector>& v_ingate,
+                       IntervalVector& outgate) const;
 
       Function *m_ibex_f = nullptr;
       std::string m_expr; // stored here because impossible to get this value from Function
+      int m_nb_threads = 1; // for the evaluations on tubes, by chunks of slices
   };
 }
 
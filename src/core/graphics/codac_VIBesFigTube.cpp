@@ -469,8 +469,8 @@ namespace codac
 
     if(traj->definition_type() == TrajDefnType::MAP_OF_VALUES)
     {
-      typename map<double,double>::const_iterator it_scalar_values;
-      for(it_scalar_values = traj->sampled_map().begin(); it_scalar_values != traj->sampled_map().end(); it_scalar_values++)
+      TrajectorySamples::const_iterator it_scalar_values;
+      for(it_scalar_values = traj->samples().begin(); it_scalar_values != traj->samples().end(); it_scalar_values++)
       {
         if(m_map_trajs[traj].points_size != 0.)
           draw_point(ThickPoint(it_scalar_values->first, it_scalar_values->second), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
@@ -0,0 +1,205 @@
+/**
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include "codac_MappedTube.h"
+#include "codac_Exception.h"
+
+#ifdef _WIN32
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    // Definition
+
+    MappedTube::MappedTube(const string& binary_file_name)
+    {
+      #ifdef _WIN32
+
+        HANDLE file = CreateFileA(binary_file_name.c_str(), GENERIC_READ, FILE_SHARE_READ,
+          NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+          throw Exception(__func__, "error while opening file \"" + binary_file_name + "\"");
+
+        LARGE_INTEGER file_size;
+        HANDLE mapping = NULL;
+        if(GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+          mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mapping)
+        {
+          m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+          m_size = file_size.QuadPart;
+          CloseHandle(mapping); // the view keeps the mapping alive
+        }
+        CloseHandle(file);
+
+        if(!m_data)
+          throw Exception(__func__, "error while mapping file \"" + binary_file_name + "\"");
+
+      #else
+
+        int fd = open(binary_file_name.c_str(), O_RDONLY);
+        if(fd < 0)
+          throw Exception(__func__, "error while opening file \"" + binary_file_name + "\"");
+
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+        {
+          void *data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+          if(data != MAP_FAILED)
+          {
+            m_data = data;
+            m_size = file_stat.st_size;
+          }
+        }
+        close(fd); // the mapping stays valid
+
+        if(!m_data)
+          throw Exception(__func__, "error while mapping file \"" + binary_file_name + "\"");
+
+      #endif
+
+      const char *data = static_cast<const char*>(m_data);
+      m_header = reinterpret_cast<const TubeFileHeader*>(data);
+
+      if(m_size < sizeof(TubeFileHeader) || !m_header->is_valid(m_size))
+      {
+        unmap();
+        throw Exception(__func__, "\"" + binary_file_name + "\" is not a tube serialized in version 3");
+      }
+
+      // The arrays have been aligned in the file, so they can be read in place
+      m_tdomains = reinterpret_cast<const double*>(data + m_header->offset_tdomains);
+      m_codomains = reinterpret_cast<const double*>(data + m_header->offset_codomains);
+      m_gates = reinterpret_cast<const double*>(data + m_header->offset_gates);
+    }
+
+    MappedTube::~MappedTube()
+    {
+      unmap();
+    }
+
+    const Interval MappedTube::tdomain() const
+    {
+      return Interval(m_tdomains[0], m_tdomains[nb_slices()]);
+    }
+
+    double MappedTube::timestep() const
+    {
+      return m_header->timestep;
+    }
+
+    const Tube MappedTube::to_tube() const
+    {
+      Tube *ptr;
+      deserialize_Tube(nb_slices(), m_tdomains, m_codomains, m_gates, timestep(), ptr);
+      Tube x(*ptr);
+      delete ptr;
+      return x;
+    }
+
+    // Slices structure
+
+    int MappedTube::nb_slices() const
+    {
+      return m_header->nb_slices;
+    }
+
+    const Interval MappedTube::slice_tdomain(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return Interval(m_tdomains[slice_id], m_tdomains[slice_id+1]);
+    }
+
+    int MappedTube::time_to_index(double t) const
+    {
+      assert(tdomain().contains(t));
+      const int n = nb_slices();
+      int i = upper_bound(m_tdomains, m_tdomains + n + 1, t) - m_tdomains - 1;
+      return std::min(std::max(i, 0), n-1); // t = tf: last slice
+    }
+
+    // Accessing values
+
+    const Interval MappedTube::codomain() const
+    {
+      const int n = nb_slices();
+      Interval y = interval(m_gates);
+      for(int i = 0 ; i < n ; i++)
+      {
+        y |= interval(m_codomains + 2*i);
+        y |= interval(m_gates + 2*(i+1));
+      }
+      return y;
+    }
+
+    const Interval MappedTube::operator()(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return interval(m_codomains + 2*slice_id);
+    }
+
+    const Interval MappedTube::operator()(double t) const
+    {
+      const int i = time_to_index(t);
+      if(t == m_tdomains[i])
+        return input_gate(i);
+      else if(t == m_tdomains[i+1])
+        return output_gate(i);
+      return (*this)(i);
+    }
+
+    const Interval MappedTube::input_gate(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return interval(m_gates + 2*slice_id);
+    }
+
+    const Interval MappedTube::output_gate(int slice_id) const
+    {
+      assert(slice_id >= 0 && slice_id < nb_slices());
+      return interval(m_gates + 2*(slice_id+1));
+    }
+
+  // Protected methods
+
+    void MappedTube::unmap()
+    {
+      if(!m_data)
+        return;
+
+      #ifdef _WIN32
+        UnmapViewOfFile(m_data);
+      #else
+        munmap(m_data, m_size);
+      #endif
+
+      m_data = nullptr;
+    }
+
+    const Interval MappedTube::interval(const double *bounds)
+    {
+      return std::isnan(bounds[0]) ? Interval::EMPTY_SET : Interval(bounds[0], bounds[1]);
+    }
+}
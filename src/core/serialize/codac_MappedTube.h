@@ -0,0 +1,175 @@
+/**
+ *  \file
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_MAPPEDTUBE_H__
+#define __CODAC_MAPPEDTUBE_H__
+
+#include <string>
+#include <cstddef>
+#include "codac_Interval.h"
+#include "codac_Tube.h"
+#include "codac_serialize_tubes.h"
+
+namespace codac
+{
+  /**
+   * \class MappedTube
+   * \brief Read-only view of a Tube serialized in a binary file (version 3)
+   *
+   * The file is mapped in memory and its arrays are read in place: opening
+   * the view does not depend on the number of slices, and the pages of the
+   * file are loaded on demand by the OS, their cache being shared between
+   * the processes reading the same file.
+   *
+   * \note The tube is expected at the beginning of the file, as written by Tube::serialize()
+   */
+  class MappedTube
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Maps a serialized tube in memory
+       *
+       * \param binary_file_name path to the binary file, written in version 3
+       */
+      explicit MappedTube(const std::string& binary_file_name);
+
+      /**
+       * \brief MappedTube destructor, the file is unmapped
+       */
+      ~MappedTube();
+
+      MappedTube(const MappedTube&) = delete;
+      MappedTube& operator=(const MappedTube&) = delete;
+
+      /**
+       * \brief Returns the temporal definition domain of this tube
+       *
+       * \return an Interval object \f$[t_0,t_f]\f$
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Returns the timestep of the tube, if its slices are uniformly distributed
+       *
+       * \return the timestep, or 0 if the slicing is not uniform
+       */
+      double timestep() const;
+
+      /**
+       * \brief Creates a Tube object from the mapped values (copy)
+       *
+       * \return the tube
+       */
+      const Tube to_tube() const;
+
+      /// @}
+      /// \name Slices structure
+      /// @{
+
+      /**
+       * \brief Returns the number of slices of this tube
+       *
+       * \return an integer
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal definition domain of the ith slice
+       *
+       * \param slice_id the index of the ith slice
+       * \return an Interval object \f$[t_i,t_{i+1}]\f$
+       */
+      const Interval slice_tdomain(int slice_id) const;
+
+      /**
+       * \brief Returns the index of the slice related to the temporal key \f$t\f$
+       *
+       * \note Computed by binary search on the mapped bounds of the slices
+       *
+       * \param t the temporal key (double, must belong to the tube's tdomain)
+       * \return an integer
+       */
+      int time_to_index(double t) const;
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the envelope of the tube, computed by one pass on the mapped values
+       *
+       * \return the hull of the codomains and the gates
+       */
+      const Interval codomain() const;
+
+      /**
+       * \brief Returns the value of the ith slice
+       *
+       * \param slice_id the index of the ith slice
+       * \return Interval value of \f$[x](i)\f$
+       */
+      const Interval operator()(int slice_id) const;
+
+      /**
+       * \brief Returns the evaluation of this tube at \f$t\f$
+       *
+       * \param t the temporal key (double, must belong to the tube's tdomain)
+       * \return the gate at \f$t\f$ if \f$t\f$ is a bound of a slice, or the value of the slice otherwise
+       */
+      const Interval operator()(double t) const;
+
+      /**
+       * \brief Returns the input gate of the ith slice
+       *
+       * \param slice_id the index of the ith slice
+       * \return Interval value of \f$[x](t_i)\f$
+       */
+      const Interval input_gate(int slice_id) const;
+
+      /**
+       * \brief Returns the output gate of the ith slice
+       *
+       * \param slice_id the index of the ith slice
+       * \return Interval value of \f$[x](t_{i+1})\f$
+       */
+      const Interval output_gate(int slice_id) const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Unmaps the file, if mapped
+       */
+      void unmap();
+
+      /**
+       * \brief Returns the interval stored as a pair of bounds
+       *
+       * \param bounds pointer to the lower bound, NaN values standing for the empty set
+       * \return the interval
+       */
+      static const Interval interval(const double *bounds);
+
+      void *m_data = nullptr; //!< mapped file
+      std::size_t m_size = 0; //!< size of the mapped file, in bytes
+      const TubeFileHeader *m_header = nullptr; //!< header of the serialized tube
+      const double *m_tdomains = nullptr; //!< n+1 bounds of the tdomains of the slices (in place)
+      const double *m_codomains = nullptr; //!< n codomains, as pairs of bounds (in place)
+      const double *m_gates = nullptr; //!< n+1 gates, as pairs of bounds (in place)
+  };
+}
+
+#endif
@@ -35,13 +35,14 @@ namespace codac
         break;
 
       case 2:
+      case 3: // unchanged in version 3
       {
         // Points number
-        int pts_number = traj.sampled_map().size();
+        int pts_number = traj.samples().size();
         bin_file.write((const char*)&pts_number, sizeof(int));
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = traj.sampled_map().begin() ; it_map != traj.sampled_map().end() ; it_map++)
+        TrajectorySamples::const_iterator it_map;
+        for(it_map = traj.samples().begin() ; it_map != traj.samples().end() ; it_map++)
         {
           bin_file.write((const char*)&it_map->first, sizeof(double));
           bin_file.write((const char*)&it_map->second, sizeof(double));
@@ -71,12 +72,14 @@ namespace codac
         break;
 
       case 2:
+      case 3: // unchanged in version 3
       {
         traj = new Trajectory();
 
         // Points number
         int pts_number;
         bin_file.read((char*)&pts_number, sizeof(int));
+        traj->m_map_values.reserve(pts_number);
 
         for(int i = 0 ; i < pts_number ; i++)
         {
@@ -8,6 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cassert>
 #include "codac_serialize_tubes.h"
 #include "codac_serialize_intervals.h"
 #include "codac_Exception.h"
@@ -20,6 +24,73 @@ using namespace ibex;
 
 namespace codac
 {
+  const uint16_t TUBE_FILE_BYTE_ORDER = 0x0102;
+  const uint64_t TUBE_FILE_ALIGNMENT = 64; // bytes, cache line
+
+  // True if [offset,offset+size] is included in [0,end], without overflow
+  static bool fits(uint64_t offset, uint64_t size, uint64_t end)
+  {
+    return offset <= end && size <= end - offset;
+  }
+
+  bool TubeFileHeader::is_valid(uint64_t available_size) const
+  {
+    const uint64_t n = nb_slices; // sizes below are then bounded, no overflow
+    return version == 3
+      && byte_order == TUBE_FILE_BYTE_ORDER
+      && header_size == sizeof(TubeFileHeader)
+      && n >= 1 && n < (uint64_t)numeric_limits<int>::max()
+      && record_size <= available_size
+      && offset_tdomains >= header_size
+      && fits(offset_tdomains, (n+1)*sizeof(double), offset_codomains)
+      && fits(offset_codomains, 2*n*sizeof(double), offset_gates)
+      && fits(offset_gates, 2*(n+1)*sizeof(double), record_size);
+  }
+
+  // Offset from the beginning of a record, such that the related position in the file is aligned
+  static uint64_t aligned_offset(streampos record_start, uint64_t offset)
+  {
+    const uint64_t pos = (uint64_t)(streamoff)record_start + offset;
+    return offset + (TUBE_FILE_ALIGNMENT - pos % TUBE_FILE_ALIGNMENT) % TUBE_FILE_ALIGNMENT;
+  }
+
+  static void push_bounds(vector<double>& v, const Interval& x)
+  {
+    if(x.is_empty())
+    {
+      v.push_back(numeric_limits<double>::quiet_NaN());
+      v.push_back(numeric_limits<double>::quiet_NaN());
+    }
+
+    else
+    {
+      v.push_back(x.lb());
+      v.push_back(x.ub());
+    }
+  }
+
+  static const Interval interval_from_bounds(const double *bounds)
+  {
+    return std::isnan(bounds[0]) ? Interval::EMPTY_SET : Interval(bounds[0], bounds[1]);
+  }
+
+  // Writes an array at a given offset of a record, after a padding
+  static void write_array(ofstream& bin_file, streampos record_start, uint64_t offset, const vector<double>& v)
+  {
+    const streamoff padding = (record_start + (streamoff)offset) - bin_file.tellp();
+    assert(padding >= 0 && padding < (streamoff)TUBE_FILE_ALIGNMENT);
+    const char zeros[TUBE_FILE_ALIGNMENT] = {};
+    bin_file.write(zeros, padding);
+    bin_file.write((const char*)v.data(), v.size()*sizeof(double));
+  }
+
+  // Reads an array at a given offset of a record
+  static void read_array(ifstream& bin_file, streampos record_start, uint64_t offset, vector<double>& v)
+  {
+    bin_file.seekg(record_start + (streamoff)offset);
+    bin_file.read((char*)v.data(), v.size()*sizeof(double));
+  }
+
   void serialize_Tube(ofstream& bin_file, const Tube& tube, int version_number)
   {
     if(!bin_file.is_open())
@@ -62,6 +133,52 @@ namespace codac
         break;
       }
 
+      case 3:
+      {
+        const streampos record_start = bin_file.tellp();
+        if(record_start == streampos(-1))
+          throw Exception(__func__, "ofstream& bin_file not writable");
+
+        const uint64_t n = tube.nb_slices();
+
+        TubeFileHeader header = {};
+        header.version = version_number;
+        header.byte_order = TUBE_FILE_BYTE_ORDER;
+        header.header_size = sizeof(TubeFileHeader);
+        header.nb_slices = n;
+        header.timestep = tube.timestep();
+        header.offset_tdomains = aligned_offset(record_start, header.header_size);
+        header.offset_codomains = aligned_offset(record_start, header.offset_tdomains + (n+1)*sizeof(double));
+        header.offset_gates = aligned_offset(record_start, header.offset_codomains + 2*n*sizeof(double));
+        header.record_size = header.offset_gates + 2*(n+1)*sizeof(double);
+        bin_file.write((const char*)&header, sizeof(TubeFileHeader));
+
+        // Each array is written at once
+        vector<double> v;
+        v.reserve(2*(n+1));
+
+        // Domains
+        for(const Slice *s = tube.first_slice() ; s ; s = s->next_slice())
+          v.push_back(s->tdomain().lb());
+        v.push_back(tube.tdomain().ub());
+        write_array(bin_file, record_start, header.offset_tdomains, v);
+
+        // Codomains
+        v.clear();
+        for(const Slice *s = tube.first_slice() ; s ; s = s->next_slice())
+          push_bounds(v, s->codomain());
+        write_array(bin_file, record_start, header.offset_codomains, v);
+
+        // Gates
+        v.clear();
+        push_bounds(v, tube.first_slice()->input_gate());
+        for(const Slice *s = tube.first_slice() ; s ; s = s->next_slice())
+          push_bounds(v, s->output_gate());
+        write_array(bin_file, record_start, header.offset_gates, v);
+
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -84,8 +201,6 @@ namespace codac
 
       case 2:
       {
-        tube = new Tube();
-
         // Slices number
         int slices_number;
         bin_file.read((char*)&slices_number, sizeof(int));
@@ -93,63 +208,65 @@ namespace codac
         if(slices_number < 1)
           throw Exception(__func__, "wrong slices number");
 
-        // Creating slices
-        double lb;
-        bin_file.read((char*)&lb, sizeof(double));
-        Interval tube_tdomain(lb);
-
-        Slice *prev_slice = nullptr, *slice = nullptr;
-        for(int k = 0 ; k < slices_number ; k++)
-        {
-          double ub;
-          bin_file.read((char*)&ub, sizeof(double));
-          tube_tdomain |= Interval(lb, ub);
-
-          if(slice == nullptr)
-          {
-            slice = new Slice(Interval(lb, ub));
-            tube->m_first_slice = slice;
-          }
-
-          else
-          {
-            slice->m_next_slice = new Slice(Interval(lb, ub));
-            slice = slice->next_slice();
-          }
-
-          if(prev_slice)
-          {
-            delete slice->m_input_gate;
-            slice->m_input_gate = nullptr;
-            Slice::chain_slices(prev_slice, slice);
-          }
-
-          prev_slice = slice;
-          lb = ub;
-        }
+        // Domains
+        vector<double> v_t(slices_number+1);
+        bin_file.read((char*)v_t.data(), v_t.size()*sizeof(double));
 
         // Codomains
-        for(Slice *s = tube->first_slice() ; s ; s = s->next_slice())
+        vector<double> v_y;
+        v_y.reserve(2*slices_number);
+        for(int k = 0 ; k < slices_number ; k++)
         {
           Interval slice_value;
           deserialize_Interval(bin_file, slice_value);
-          s->set(slice_value);
+          push_bounds(v_y, slice_value);
         }
 
-        // Domain
-        tube_tdomain |= lb;
-        tube->m_tdomain = tube_tdomain; // redundant information for fast access
-
         // Gates
-        Interval gate;
-        deserialize_Interval(bin_file, gate);
-        tube->first_slice()->set_input_gate(gate);
-        for(Slice *s = tube->first_slice() ; s ; s = s->next_slice())
+        vector<double> v_gates;
+        v_gates.reserve(2*(slices_number+1));
+        for(int k = 0 ; k < slices_number+1 ; k++)
         {
+          Interval gate;
           deserialize_Interval(bin_file, gate);
-          s->set_output_gate(gate);
+          push_bounds(v_gates, gate);
         }
-        
+
+        deserialize_Tube(slices_number, v_t.data(), v_y.data(), v_gates.data(), 0., tube);
+        break;
+      }
+
+      case 3:
+      {
+        const streampos record_start = bin_file.tellg() - (streamoff)sizeof(short int);
+
+        TubeFileHeader header;
+        header.version = version_number;
+        bin_file.read((char*)&header + sizeof(short int), sizeof(TubeFileHeader) - sizeof(short int));
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        // The record must fit in the file before allocating from its header
+        const streampos header_end = bin_file.tellg();
+        bin_file.seekg(0, ios::end);
+        const streamoff available_size = bin_file.tellg() - record_start;
+        bin_file.seekg(header_end);
+
+        if(!bin_file || available_size < 0 || !header.is_valid((uint64_t)available_size))
+          throw Exception(__func__, "invalid header");
+
+        const int n = header.nb_slices;
+        vector<double> v_t(n+1), v_y(2*n), v_gates(2*(n+1));
+        read_array(bin_file, record_start, header.offset_tdomains, v_t);
+        read_array(bin_file, record_start, header.offset_codomains, v_y);
+        read_array(bin_file, record_start, header.offset_gates, v_gates);
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        deserialize_Tube(n, v_t.data(), v_y.data(), v_gates.data(), header.timestep, tube);
+        bin_file.seekg(record_start + (streamoff)header.record_size); // next object, if any
         break;
       }
 
@@ -158,6 +275,40 @@ namespace codac
     }
   }
 
+  void deserialize_Tube(int nb_slices, const double *tdomains, const double *codomains, const double *gates, double timestep, Tube *&tube)
+  {
+    assert(nb_slices > 0);
+    tube = new Tube();
+
+    // Creating slices, the values being set at once:
+    // the tube has been serialized in a consistent state
+    Slice *prev_slice = nullptr;
+    for(int k = 0 ; k < nb_slices ; k++)
+    {
+      Slice *slice = new Slice(Interval(tdomains[k], tdomains[k+1]));
+      slice->m_codomain = interval_from_bounds(codomains + 2*k);
+
+      if(prev_slice)
+      {
+        Slice::delete_gate(slice->m_input_gate);
+        slice->m_input_gate = nullptr;
+        Slice::chain_slices(prev_slice, slice);
+      }
+
+      else
+      {
+        tube->m_first_slice = slice;
+        *slice->m_input_gate = interval_from_bounds(gates);
+      }
+
+      *slice->m_output_gate = interval_from_bounds(gates + 2*(k+1));
+      prev_slice = slice;
+    }
+
+    tube->m_tdomain = Interval(tdomains[0], tdomains[nb_slices]); // redundant information for fast access
+    tube->m_timestep = timestep;
+  }
+
   void serialize_TubeVector(ofstream& bin_file, const TubeVector& tube, int version_number)
   {
     if(!bin_file.is_open())
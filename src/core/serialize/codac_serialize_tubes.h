@@ -13,21 +13,70 @@
 #define __CODAC_SERIALIZ_TUBES_H__
 
 #include <fstream>
+#include <cstdint>
 
 namespace codac
 {
-  #define SERIALIZATION_VERSION 2
+  #define SERIALIZATION_VERSION 3
 
   class Tube;
   class TubeVector;
 
+  /**
+   * \struct TubeFileHeader
+   * \brief Header of a Tube serialized in version 3
+   *
+   * The header is followed by three arrays of doubles, each one aligned
+   * on 64 bytes in the file, so that a mapped file can be read in place
+   * (see MappedTube). The offsets are given from the beginning of the header.
+   */
+  struct TubeFileHeader
+  {
+    std::int16_t version; //!< serialization version number (3), first field as in the previous versions
+    std::uint16_t byte_order; //!< 0x0102 in the byte order of the writer
+    std::uint32_t header_size; //!< size of this header, in bytes
+    std::uint64_t nb_slices; //!< number \f$n\f$ of slices
+    std::uint64_t record_size; //!< size of the header, the paddings and the arrays, in bytes
+    std::uint64_t offset_tdomains; //!< offset of the \f$n+1\f$ bounds of the tdomains of the slices
+    std::uint64_t offset_codomains; //!< offset of the \f$n\f$ codomains, as pairs of bounds
+    std::uint64_t offset_gates; //!< offset of the \f$n+1\f$ gates, as pairs of bounds
+    double timestep; //!< timestep of a uniform slicing, or 0
+    std::uint64_t reserved; //!< unused, the header filling one cache line
+
+    /**
+     * \brief Tests the consistency of this header
+     *
+     * \param available_size size of the data available from the beginning of the header, in bytes
+     * \return true if the arrays fit in the record, and the record in the available data
+     */
+    bool is_valid(std::uint64_t available_size) const;
+  };
+
+  static_assert(sizeof(TubeFileHeader) == 64, "unexpected padding in TubeFileHeader");
+
   /// \name Tube
   /// @{
 
   /**
-   * \brief Writes a Tube object into a binary file (version 2)
+   * \brief Writes a Tube object into a binary file
    * 
-   * Tube binary structure: <br>
+   * Tube binary structure (version 3): <br>
+   *   [TubeFileHeader] // the version number being the first field <br>
+   *   [padding] <br>
+   *   [double_t0] // bounds of the tdomains of the slices, aligned on 64 bytes <br>
+   *   [double_t1] <br>
+   *   ... <br>
+   *   [double_tn] <br>
+   *   [padding] <br>
+   *   [double_lb_y0][double_ub_y0] // value of 1rst slice, aligned on 64 bytes <br>
+   *   ... <br>
+   *   [padding] <br>
+   *   [double_lb_gate_t0][double_ub_gate_t0] // value of 1rst gate, aligned on 64 bytes <br>
+   *   ...
+   *
+   * An empty interval is stored as a pair of NaN values.
+   *
+   * Tube binary structure (version 2): <br>
    *   [short_int_version_number] <br>
    *   [int_nb_slices] <br>
    *   [double_t0] <br>
@@ -57,6 +106,18 @@ namespace codac
    */
   void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
 
+  /**
+   * \brief Creates a Tube object from the arrays of a version 3 record
+   *
+   * \param nb_slices number \f$n\f$ of slices
+   * \param tdomains the \f$n+1\f$ bounds of the tdomains of the slices
+   * \param codomains the \f$n\f$ codomains, as pairs of bounds
+   * \param gates the \f$n+1\f$ gates, as pairs of bounds
+   * \param timestep timestep of a uniform slicing, or 0
+   * \param tube Tube object to be created
+   */
+  void deserialize_Tube(int nb_slices, const double *tdomains, const double *codomains, const double *gates, double timestep, Tube *&tube);
+
   /// @}
   /// \name TubeVector
   /// @{
@@ -0,0 +1,300 @@
+/**
+ *  \file
+ *  SlabAllocator class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_SLABALLOCATOR_H__
+#define __CODAC_SLABALLOCATOR_H__
+
+#include <new>
+#include <mutex>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace codac
+{
+  /**
+   * \class SlabAllocator
+   * \brief Fixed-size allocator of objects of type `T`, served from contiguous chunks of memory
+   *
+   * Objects allocated one after the other (for instance the slices of a tube, at its
+   * construction) are stored next to each other, which makes the traversal of
+   * linked structures cache friendly. Memory is never moved, so that pointers to the
+   * allocated objects stay valid.
+   *
+   * With the allocator of a type, see instance(), each thread keeps its own list
+   * of free blocks: allocations and deallocations do not lock, except for exchanging
+   * batches of blocks with the shared pool of the allocator. The blocks cached by
+   * a thread are given back at its exit. Other allocators lock their pool at each
+   * allocation or deallocation.
+   *
+   * \note Allocations and deallocations are thread safe.
+   */
+  template<typename T>
+  class SlabAllocator
+  {
+    public:
+
+      /**
+       * \brief Returns the allocator of objects of type `T`
+       *
+       * \return a reference to the allocator
+       */
+      static SlabAllocator& instance()
+      {
+        // Never destroyed: static objects (tubes) may be released at exit,
+        // after the destruction of the other static objects
+        static SlabAllocator *allocator = new SlabAllocator(64, 65536, true);
+        return *allocator;
+      }
+
+      /**
+       * \brief Creates an allocator, without thread caches
+       *
+       * \param chunk_size number of objects of the first chunk,
+       *        the size of the next chunks is doubled up to `max_chunk_size`
+       * \param max_chunk_size maximal number of objects per chunk
+       */
+      explicit SlabAllocator(std::size_t chunk_size = 64, std::size_t max_chunk_size = 65536)
+        : SlabAllocator(chunk_size, max_chunk_size, false)
+      {
+
+      }
+
+      /**
+       * \brief SlabAllocator destructor, releasing all the chunks
+       */
+      ~SlabAllocator()
+      {
+        for(auto& chunk : m_v_chunks)
+          delete[] chunk;
+      }
+
+      SlabAllocator(const SlabAllocator&) = delete;
+      SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+      /**
+       * \brief Returns uninitialized memory for one object of type `T`
+       *
+       * \return pointer to the memory block
+       */
+      void* allocate()
+      {
+        ThreadCache *cache = m_thread_caches ? thread_cache() : nullptr;
+
+        if(!cache) // no thread caches, or thread exiting
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          return take_blocks(1)->data;
+        }
+
+        if(!cache->free_list)
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          cache->free_list = take_blocks(BATCH_SIZE);
+          cache->size = BATCH_SIZE;
+        }
+
+        Block *block = cache->free_list;
+        cache->free_list = block->next;
+        cache->size--;
+        return block->data;
+      }
+
+      /**
+       * \brief Gives back a memory block obtained from allocate()
+       *
+       * \note The block may have been allocated by another thread.
+       *
+       * \param ptr pointer to the memory block, the object being already destroyed
+       */
+      void deallocate(void *ptr)
+      {
+        if(!ptr)
+          return;
+
+        Block *block = reinterpret_cast<Block*>(ptr);
+        ThreadCache *cache = m_thread_caches ? thread_cache() : nullptr;
+
+        if(!cache) // no thread caches, or thread exiting
+        {
+          block->next = nullptr;
+          put_blocks(block, block);
+          return;
+        }
+
+        block->next = cache->free_list;
+        cache->free_list = block;
+        if(++cache->size > 2*BATCH_SIZE) // bounded number of blocks per thread
+          give_back(*cache, BATCH_SIZE);
+      }
+
+      /**
+       * \brief Returns the number of objects that can be stored in the current chunks
+       *
+       * \return capacity of the allocator
+       */
+      std::size_t capacity() const
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+      }
+
+    protected:
+
+      /**
+       * \brief Creates an allocator
+       *
+       * \param chunk_size number of objects of the first chunk
+       * \param max_chunk_size maximal number of objects per chunk
+       * \param thread_caches if `true`, each thread keeps its own free blocks (allocator of a type)
+       */
+      SlabAllocator(std::size_t chunk_size, std::size_t max_chunk_size, bool thread_caches)
+        : m_chunk_size(chunk_size), m_max_chunk_size(max_chunk_size), m_thread_caches(thread_caches)
+      {
+        assert(chunk_size > 0 && chunk_size <= max_chunk_size);
+      }
+
+      /**
+       * \union Block
+       * \brief Memory for one object, or link to the next free block
+       */
+      union Block
+      {
+        Block *next; //!< next free block, when this one is not used
+        alignas(T) unsigned char data[sizeof(T)]; //!< storage of the object
+      };
+
+      /**
+       * \struct ThreadCache
+       * \brief Free blocks owned by one thread
+       */
+      struct ThreadCache
+      {
+        explicit ThreadCache(bool& destroyed) : destroyed(destroyed) { }
+
+        ~ThreadCache() // thread exit
+        {
+          destroyed = true;
+          if(size)
+            instance().give_back(*this, size);
+        }
+
+        Block *free_list = nullptr; //!< free blocks of the thread
+        std::size_t size = 0; //!< number of blocks in the free list
+        bool& destroyed; //!< flag of the thread, set at its exit
+      };
+
+      /**
+       * \brief Returns the free blocks of the calling thread
+       *
+       * \return pointer to the cache, or `nullptr` if it has been destroyed (thread exiting)
+       */
+      static ThreadCache* thread_cache()
+      {
+        // Trivially destructible: still valid once the cache is destroyed,
+        // for objects released at the exit of the thread (static tubes)
+        static thread_local bool destroyed = false;
+        if(destroyed)
+          return nullptr;
+
+        static thread_local ThreadCache cache(destroyed);
+        return &cache;
+      }
+
+      /**
+       * \brief Takes blocks from the shared pool, recycled ones first (`m_mutex` locked)
+       *
+       * \param nb number of blocks
+       * \return linked list of `nb` free blocks
+       */
+      Block* take_blocks(std::size_t nb)
+      {
+        Block *first = nullptr, **last = &first;
+
+        for(std::size_t i = 0 ; i < nb ; i++)
+        {
+          Block *block;
+
+          if(m_free_list)
+          {
+            block = m_free_list;
+            m_free_list = block->next;
+          }
+
+          else
+          {
+            if(m_next == m_end)
+            {
+              Block *chunk = new Block[m_chunk_size];
+              m_v_chunks.push_back(chunk);
+              m_next = chunk;
+              m_end = chunk + m_chunk_size;
+              m_capacity += m_chunk_size;
+              m_chunk_size = std::min(2*m_chunk_size, m_max_chunk_size);
+            }
+
+            block = m_next++; // contiguous blocks, in the order of the allocations
+          }
+
+          *last = block;
+          last = &block->next;
+        }
+
+        *last = nullptr;
+        return first;
+      }
+
+      /**
+       * \brief Moves the first blocks of a thread cache to the shared pool
+       *
+       * \param cache free blocks of the thread
+       * \param nb number of blocks to be given back, not greater than the size of the cache
+       */
+      void give_back(ThreadCache& cache, std::size_t nb)
+      {
+        assert(nb > 0 && nb <= cache.size);
+
+        Block *first = cache.free_list, *last = first;
+        for(std::size_t i = 1 ; i < nb ; i++)
+          last = last->next;
+        cache.free_list = last->next;
+        cache.size -= nb;
+        put_blocks(first, last);
+      }
+
+      /**
+       * \brief Moves a linked list of blocks to the shared pool
+       *
+       * \param first first block of the list
+       * \param last last block of the list
+       */
+      void put_blocks(Block *first, Block *last)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        last->next = m_free_list;
+        m_free_list = first;
+      }
+
+      static const std::size_t BATCH_SIZE = 64; //!< number of blocks exchanged with the shared pool
+
+      mutable std::mutex m_mutex; //!< protection of the shared pool
+      std::vector<Block*> m_v_chunks; //!< contiguous chunks of blocks
+      Block *m_free_list = nullptr; //!< released blocks, to be reused first
+      Block *m_next = nullptr, *m_end = nullptr; //!< unused part of the last chunk
+      std::size_t m_capacity = 0; //!< total number of blocks of the chunks
+      std::size_t m_chunk_size; //!< number of blocks of the next chunk
+      const std::size_t m_max_chunk_size; //!< maximal number of blocks per chunk
+      const bool m_thread_caches; //!< true if the threads keep their own free blocks
+  };
+}
+
+#endif
@@ -12,6 +12,10 @@
 #include <sstream>
 #include <algorithm>
 #include <functional>
+#include <thread>
+#include <exception>
+#include <vector>
+#include <cassert>
 #include "codac_Tools.h"
 
 using namespace std;
@@ -46,4 +50,40 @@ namespace codac
     // outside this function, on demand.
     return max(itv.lb(),min(itv.ub(),rand()/double(RAND_MAX)*itv.diam()+itv.lb()));
   }
+
+  void Tools::parallel_chunks(int n, int nb_chunks, const function<void(int,int,int)>& f)
+  {
+    assert(n >= 0 && nb_chunks > 0);
+
+    if(nb_chunks == 1)
+    {
+      f(0, 0, n);
+      return;
+    }
+
+    vector<exception_ptr> v_errors(nb_chunks);
+    auto run = [&](int c)
+    {
+      try
+      {
+        f(c, (long)c*n/nb_chunks, (long)(c+1)*n/nb_chunks);
+      }
+      catch(...)
+      {
+        v_errors[c] = current_exception();
+      }
+    };
+
+    vector<thread> v_threads;
+    for(int c = 1 ; c < nb_chunks ; c++)
+      v_threads.push_back(thread(run, c));
+    run(0); // the calling thread takes part in the computations
+
+    for(auto& t : v_threads)
+      t.join();
+
+    for(const auto& e : v_errors)
+      if(e)
+        rethrow_exception(e);
+  }
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #define __CODAC_TOOLS_H__
 
 #include <string>
+#include <functional>
 #include "codac_Interval.h"
 
 namespace codac
@@ -52,6 +53,21 @@ namespace codac
        * \return a random double
        */
       static double rand_in_bounds(const Interval& intv);
+
+      /**
+       * \brief Splits a range of indexes \f$[0,n[\f$ into chunks of contiguous indexes,
+       *        processed simultaneously by several threads
+       *
+       * \note The calling thread processes the first chunk. If a call to `f` throws
+       *       an exception, it is rethrown once all the chunks have been processed.
+       *
+       * \param n number of indexes
+       * \param nb_chunks number of chunks (and of threads), the chunk \f$c\f$ being
+       *        made of the indexes \f$[c\cdot n/\textrm{nb\_chunks},(c+1)\cdot n/\textrm{nb\_chunks}[\f$
+       * \param f function called on each chunk, with the chunk number and its first
+       *        and past-the-end indexes
+       */
+      static void parallel_chunks(int n, int nb_chunks, const std::function<void(int,int,int)>& f);
   };
 }
 
@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <mutex>
 #include <sstream>
 #include "codac_Trajectory.h"
 
@@ -16,6 +17,39 @@ using namespace ibex;
 
 namespace codac
 {
+  /**
+   * \brief Merges two sets of samples, the values of the first one being kept for common keys
+   *
+   * \param values the reference samples
+   * \param new_values the samples to be added
+   * \return the merged samples
+   */
+  static TrajectorySamples merge_samples(const TrajectorySamples& values, const TrajectorySamples& new_values)
+  {
+    TrajectorySamples merged;
+    merged.reserve(values.size() + new_values.size());
+
+    TrajectorySamples::const_iterator it1 = values.begin(), it2 = new_values.begin();
+    while(it1 != values.end() || it2 != new_values.end())
+    {
+      if(it2 == new_values.end() || (it1 != values.end() && it1->first <= it2->first))
+      {
+        if(it2 != new_values.end() && it1->first == it2->first)
+          it2++; // key already defined
+        merged.push_back(it1->first, it1->second);
+        it1++;
+      }
+
+      else
+      {
+        merged.push_back(it2->first, it2->second);
+        it2++;
+      }
+    }
+
+    return merged;
+  }
+
   // Public methods
 
     // Definition
@@ -23,7 +57,7 @@ namespace codac
     Trajectory::Trajectory()
       : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
-      m_map_values = map<double,double>();
+
     }
 
     Trajectory::Trajectory(const Trajectory& traj)
@@ -50,17 +84,27 @@ namespace codac
     }
 
     Trajectory::Trajectory(const map<double,double>& map_values)
-      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_map_values(map_values)
+      : Trajectory(TrajectorySamples(map_values))
+    {
+
+    }
+
+    Trajectory::Trajectory(const TrajectorySamples& map_values)
+      : Trajectory(TrajectorySamples(map_values))
     {
-      // todo: restore this? assert(!map_values.empty());
+
+    }
+
+    Trajectory::Trajectory(TrajectorySamples&& map_values)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_map_values(std::move(map_values))
+    {
+      // todo: restore this? assert(!m_map_values.empty());
       // todo: check that empty traj are allowed for all methods
 
-      if(!map_values.empty())
+      if(!m_map_values.empty())
       {
         // Temporal domain:
-        map<double,double>::const_iterator
-          last_it = map_values.end(); last_it--; // accessing last value
-        m_tdomain = Interval(map_values.begin()->first, last_it->first);
+        m_tdomain = Interval(m_map_values.begin()->first, m_map_values.rbegin()->first);
 
         // Codomain:
         compute_codomain();
@@ -73,6 +117,7 @@ namespace codac
       // todo: restore this? assert(!list_t.empty());
       assert(list_t.size() == list_x.size());
 
+      m_map_values.reserve(list_t.size());
       for(list<double>::const_iterator it_t = list_t.begin(), it_x = list_x.begin() ;
           it_t != list_t.end() && it_x != list_x.end();
           ++it_t, ++it_x)
@@ -130,6 +175,21 @@ namespace codac
     // Accessing values
 
     const map<double,double>& Trajectory::sampled_map() const
+    {
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+
+      static mutex sampled_map_mutex; // concurrent reads of a trajectory
+      lock_guard<mutex> lock(sampled_map_mutex);
+      if(m_sampled_map_version != m_map_values.version())
+      {
+        m_sampled_map = m_map_values.to_map();
+        m_sampled_map_version = m_map_values.version();
+      }
+
+      return m_sampled_map;
+    }
+
+    const TrajectorySamples& Trajectory::samples() const
     {
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
       return m_map_values;
@@ -156,22 +216,7 @@ namespace codac
           return m_function->eval(t).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(m_map_values.find(t) != m_map_values.end()) // key exists
-            return m_map_values.at(t);
-            // todo: optimize this to avoid double reading of the map?
-
-          else
-          {
-            typename map<double,double>::const_iterator it_lower, it_upper;
-            it_lower = m_map_values.lower_bound(t);
-            it_upper = it_lower;
-            it_lower--;
-
-            // Linear interpolation
-            return it_lower->second +
-                   (t - it_lower->first) * (it_upper->second - it_lower->second) /
-                   (it_upper->first - it_lower->first);
-          }
+          return m_map_values.interpolate(m_map_values.lower_bound(t), t);
 
         default:
           assert(false && "unhandled case");
@@ -198,8 +243,8 @@ namespace codac
           eval |= (*this)(t.lb());
           eval |= (*this)(t.ub());
 
-          for(map<double,double>::const_iterator it = m_map_values.lower_bound(t.lb()) ;
-              it != m_map_values.upper_bound(t.ub()) ; it++)
+          for(TrajectorySamples::const_iterator it = m_map_values.lower_bound(t.lb()),
+              it_end = m_map_values.upper_bound(t.ub()) ; it != it_end ; it++)
             eval |= it->second;
           break;
 
@@ -270,13 +315,14 @@ namespace codac
         if(m_tdomain != x.tdomain() || m_codomain != x.codomain())
           return false;
 
-        typename map<double,double>::const_iterator it_map;
+        TrajectorySamples::const_iterator it_map;
         for(it_map = m_map_values.begin() ; it_map != m_map_values.end() ; it_map++)
         {
-          if(x.sampled_map().find(it_map->first) == x.sampled_map().end())
+          TrajectorySamples::const_iterator it_x = x.m_map_values.find(it_map->first);
+          if(it_x == x.m_map_values.end())
             return false;
 
-          if(it_map->second != x.sampled_map().at(it_map->first))
+          if(it_map->second != it_x->second)
             return false;
         }
 
@@ -303,11 +349,17 @@ namespace codac
       
       m_tdomain |= t;
 
-      bool update_codomain = m_map_values.find(t) != m_map_values.end() // key already exists
-            && m_codomain.contains(m_map_values.at(t)); // and new value inside codomain hull
+      bool update_codomain = false;
+      if(m_map_values.empty() || m_map_values.rbegin()->first < t)
+        m_map_values.push_back(t, y); // most common case: values set in increasing time order
 
-      m_map_values.erase(t);
-      m_map_values.emplace(t, y);
+      else
+      {
+        TrajectorySamples::const_iterator it = m_map_values.find(t);
+        update_codomain = it != m_map_values.end() // key already exists
+          && m_codomain.contains(it->second); // and new value inside codomain hull
+        m_map_values[t] = y;
+      }
 
       if(update_codomain) // the new codomain may be a subset of the old one
         compute_codomain();
@@ -316,6 +368,29 @@ namespace codac
         m_codomain |= y; // simple union
     }
 
+    Trajectory& Trajectory::append(const vector<double>& v_t, const vector<double>& v_y)
+    {
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES
+        && "Trajectory already defined by a TFunction");
+      assert(v_t.size() == v_y.size());
+
+      if(v_t.empty())
+        return *this;
+
+      assert((m_map_values.empty() || m_map_values.rbegin()->first < v_t.front())
+        && "values can only be appended after tf");
+
+      m_map_values.reserve(m_map_values.size() + v_t.size());
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+      {
+        m_map_values.push_back(v_t[i], v_y[i]);
+        m_codomain |= v_y[i];
+      }
+
+      m_tdomain |= Interval(v_t.front(), v_t.back());
+      return *this;
+    }
+
     Trajectory& Trajectory::truncate_tdomain(const Interval& t)
     {
       assert(valid_tdomain(t));
@@ -326,12 +401,8 @@ namespace codac
         double y_lb = (*this)(t.lb());
         double y_ub = (*this)(t.ub());
 
-        map<double,double>::iterator it = m_map_values.begin();
-        while(it != m_map_values.end())
-        {
-          if(!t.contains(it->first)) it = m_map_values.erase(it);
-          else ++it;
-        }
+        m_map_values.erase(m_map_values.upper_bound(t.ub()), m_map_values.end());
+        m_map_values.erase(m_map_values.begin(), m_map_values.lower_bound(t.lb()));
 
         m_map_values[t.lb()] = y_lb; // clean truncation
         m_map_values[t.ub()] = y_ub;
@@ -345,13 +416,7 @@ namespace codac
     Trajectory& Trajectory::shift_tdomain(double shift_ref)
     {
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-      {
-        map<double,double> map_temp = m_map_values;
-        m_map_values.clear();
-
-        for(map<double,double>::iterator it = map_temp.begin() ; it != map_temp.end() ; it++)
-          m_map_values.emplace(it->first + shift_ref, it->second);
-      }
+        m_map_values.shift(shift_ref);
 
       m_tdomain += shift_ref;
       compute_codomain();
@@ -363,7 +428,7 @@ namespace codac
       assert(m_map_values.size() > 2);
       h = next(m_map_values.begin())->first - m_map_values.begin()->first;
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ;
+      for(TrajectorySamples::const_iterator it = m_map_values.begin() ;
         next(it) != m_map_values.end() ; it++)
         if((it->first + h) != next(it)->first)
           return false;
@@ -375,16 +440,13 @@ namespace codac
     {
       assert(dt > 0.);
 
-      map<double,double> new_map;
-      
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
+      TrajectorySamples new_values;
+      new_values.reserve((size_t)(m_tdomain.diam() / dt) + 2);
 
       double t;
       for(t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
-        if(new_map.find(t) == new_map.end()) // if key does not exist already
-          new_map[t] = (*this)(t); // evaluation/interpolation
-      new_map[m_tdomain.ub()] = (*this)(m_tdomain.ub());
+        new_values.push_back(t, (*this)(t)); // evaluation/interpolation
+      new_values.push_back(m_tdomain.ub(), (*this)(m_tdomain.ub()));
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
@@ -392,7 +454,8 @@ namespace codac
         delete m_function;
       }
 
-      m_map_values = new_map;
+      // Existing keys are not modified
+      m_map_values = merge_samples(m_map_values, new_values);
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -402,14 +465,11 @@ namespace codac
       assert(tdomain() == x.tdomain());
       assert(x.m_traj_def_type == TrajDefnType::MAP_OF_VALUES && "trajectory x has to be sampled");
       
-      map<double,double> new_map;
-
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
+      TrajectorySamples new_values;
+      new_values.reserve(x.samples().size());
 
-      for(auto const& it : x.sampled_map())
-        if(new_map.find(it.first) == new_map.end()) // if key does not exist already
-          new_map[it.first] = (*this)(it.first); // evaluation/interpolation
+      for(auto const& it : x.samples())
+        new_values.push_back(it.first, (*this)(it.first)); // evaluation/interpolation
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
@@ -417,7 +477,8 @@ namespace codac
         delete m_function;
       }
 
-      m_map_values = new_map;
+      // Existing keys are not modified
+      m_map_values = merge_samples(m_map_values, new_values);
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -431,11 +492,11 @@ namespace codac
       m_codomain = Interval::EMPTY_SET;
 
       double prev_value = 0., value_mod = 0.;
-      map<double,double> m_continuous_values;
+      bool first_value = true;
 
-      for(const auto& it : m_map_values)
+      for(auto& it : m_map_values) // values updated in place
       {
-        if(!m_continuous_values.empty())
+        if(!first_value)
         {
           if(prev_value - it.second > periodicity.diam()*0.9)
             value_mod += periodicity.diam();
@@ -443,12 +504,12 @@ namespace codac
             value_mod -= periodicity.diam();
         }
 
+        first_value = false;
         prev_value = it.second;
-        m_continuous_values[it.first] = m_map_values[it.first] + value_mod;
-        m_codomain |= m_continuous_values[it.first];
+        it.second += value_mod;
+        m_codomain |= it.second;
       }
 
-      m_map_values = m_continuous_values;
       return *this;
     }
 
@@ -461,8 +522,9 @@ namespace codac
       
       double val;
       Trajectory x;
+      x.m_map_values.reserve(m_map_values.size());
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
+      for(TrajectorySamples::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
       {
         if(it == m_map_values.begin())
           val = c;
@@ -519,7 +581,7 @@ namespace codac
           {
             // Mean timestep
             double mean_h = 0.;
-            for(map<double,double>::const_iterator it = m_map_values.begin() ;
+            for(TrajectorySamples::const_iterator it = m_map_values.begin() ;
               next(it) != m_map_values.end() ; it++)
               mean_h += next(it)->first - it->first;
             mean_h /= m_map_values.size()-1;
@@ -562,7 +624,7 @@ namespace codac
       assert(m_map_values.size() > 2);
 
       vector<double> fwd;
-      map<double,double>::const_iterator it_fwd = m_map_values.find(t);
+      TrajectorySamples::const_iterator it_fwd = m_map_values.find(t);
       double x = it_fwd->second;
 
       it_fwd++;
@@ -573,7 +635,7 @@ namespace codac
       }
 
       vector<double> bwd;
-      map<double,double>::const_iterator it_bwd = m_map_values.find(t);
+      TrajectorySamples::const_iterator it_bwd = m_map_values.find(t);
 
       if(it_bwd != m_map_values.begin())
       {
@@ -652,7 +714,7 @@ namespace codac
           if(x.m_map_values.size() < 10)
           {
             str << ", " << x.m_map_values.size() << " pts: { ";
-            for(map<double,double>::const_iterator it = x.m_map_values.begin() ; it != x.m_map_values.end() ; it++)
+            for(TrajectorySamples::const_iterator it = x.m_map_values.begin() ; it != x.m_map_values.end() ; it++)
               str << "(" << it->first << "," << it->second << ") ";
             str << "} ";
           }
@@ -688,8 +750,8 @@ namespace codac
 
         case TrajDefnType::MAP_OF_VALUES:
           m_codomain = Interval::EMPTY_SET;
-          for(map<double,double>::iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
-            m_codomain |= it->second;
+          for(const auto& it : m_map_values)
+            m_codomain |= it.second;
           break;
 
         default:
@@ -14,7 +14,9 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include "codac_DynamicalItem.h"
+#include "codac_TrajectorySamples.h"
 #include "codac_TFunction.h"
 #include "codac_traj_arithmetic.h"
 
@@ -70,6 +72,20 @@ namespace codac
        */
       explicit Trajectory(const std::map<double,double>& m_map_values);
 
+      /**
+       * \brief Creates a scalar trajectory \f$x(\cdot)\f$ from sorted samples
+       *
+       * \param m_map_values samples (t,y) defining the trajectory: \f$x(t)=y\f$
+       */
+      explicit Trajectory(const TrajectorySamples& m_map_values);
+
+      /**
+       * \brief Creates a scalar trajectory \f$x(\cdot)\f$ from sorted samples, without copy
+       *
+       * \param m_map_values samples (t,y) defining the trajectory: \f$x(t)=y\f$
+       */
+      explicit Trajectory(TrajectorySamples&& m_map_values);
+
       /**
        * \brief Creates a scalar trajectory \f$x(\cdot)\f$ from a list of values
        *
@@ -128,10 +144,21 @@ namespace codac
       /**
        * \brief Returns the map of values, if the object is defined as a map
        *
+       * \deprecated The values are not stored in a map anymore: this map is built
+       *             from samples() at the first call following a change of the values.
+       *             Use samples() instead.
+       *
        * \return a map<t,y> of values, or an empty map
        */
       const std::map<double,double>& sampled_map() const;
 
+      /**
+       * \brief Returns the sorted values, if the object is defined as a map
+       *
+       * \return the samples (t,y), or empty samples
+       */
+      const TrajectorySamples& samples() const;
+
       /**
        * \brief Returns the temporal function, if the object is an analytic trajectory
        *
@@ -223,6 +250,17 @@ namespace codac
        */
       void set(double y, double t);
 
+      /**
+       * \brief Appends values after \f$t_f\f$, in one pass
+       *
+       * \note The trajectory must not be defined from an analytic function
+       *
+       * \param v_t increasing temporal keys, greater than \f$t_f\f$
+       * \param v_y values of the trajectory at these keys
+       * \return a reference to this trajectory
+       */
+      Trajectory& append(const std::vector<double>& v_t, const std::vector<double>& v_y);
+
       /**
        * \brief Truncates the tdomain of \f$x(\cdot)\f$
        *
@@ -462,9 +500,12 @@ namespace codac
         //union
         //{
           TFunction *m_function = nullptr; //!< optional pointer to the analytic expression of this trajectory
-          std::map<double,double> m_map_values; //!< optional map of values <t,y>: \f$x(t)=y\f$
+          TrajectorySamples m_map_values; //!< optional sorted values <t,y>: \f$x(t)=y\f$
         //};
 
+        mutable std::map<double,double> m_sampled_map; //!< copy of the values for sampled_map() (deprecated)
+        mutable std::uint64_t m_sampled_map_version = 0; //!< version of the values copied in m_sampled_map
+
       friend void deserialize_Trajectory(std::ifstream& bin_file, Trajectory *&traj);
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
   };
@@ -0,0 +1,177 @@
+/**
+ *  TrajectorySamples class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <atomic>
+#include <algorithm>
+#include "codac_TrajectorySamples.h"
+
+using namespace std;
+
+namespace codac
+{
+  // Public methods
+
+    // Definition
+
+    TrajectorySamples::TrajectorySamples()
+    {
+
+    }
+
+    TrajectorySamples::TrajectorySamples(const map<double,double>& map_values)
+    {
+      m_v_values.reserve(map_values.size());
+      for(const auto& it : map_values) // already sorted
+        m_v_values.push_back(it);
+    }
+
+    map<double,double> TrajectorySamples::to_map() const
+    {
+      map<double,double> map_values;
+      for(const auto& it : m_v_values)
+        map_values.emplace_hint(map_values.end(), it);
+      return map_values;
+    }
+
+    uint64_t TrajectorySamples::version() const
+    {
+      static atomic<uint64_t> last_version{0};
+      if(m_version == 0) // modified: new identifier
+        m_version = ++last_version;
+      return m_version;
+    }
+
+    // Accessing values
+
+    TrajectorySamples::const_iterator TrajectorySamples::find(double t) const
+    {
+      size_t i = search(t, false);
+      if(i < m_v_values.size() && m_v_values[i].first == t)
+        return m_v_values.begin() + i;
+      return m_v_values.end();
+    }
+
+    TrajectorySamples::const_iterator TrajectorySamples::lower_bound(double t) const
+    {
+      return m_v_values.begin() + search(t, false);
+    }
+
+    TrajectorySamples::const_iterator TrajectorySamples::upper_bound(double t) const
+    {
+      return m_v_values.begin() + search(t, true);
+    }
+
+    double TrajectorySamples::at(double t) const
+    {
+      const_iterator it = find(t);
+      assert(it != m_v_values.end() && "unknown time key");
+      return it->second;
+    }
+
+    double& TrajectorySamples::operator[](double t)
+    {
+      m_version = 0;
+
+      if(m_v_values.empty() || m_v_values.back().first < t) // most common case: appending
+      {
+        m_v_values.emplace_back(t, 0.);
+        return m_v_values.back().second;
+      }
+
+      size_t i = search(t, false);
+      if(m_v_values[i].first != t)
+        m_v_values.emplace(m_v_values.begin() + i, t, 0.);
+      return m_v_values[i].second;
+    }
+
+    double TrajectorySamples::interpolate(const_iterator it_upper, double t) const
+    {
+      assert(it_upper != m_v_values.end());
+      if(it_upper->first == t) // key exists
+        return it_upper->second;
+
+      assert(it_upper != m_v_values.begin());
+      const_iterator it_lower = prev(it_upper);
+
+      // Linear interpolation
+      return it_lower->second +
+             (t - it_lower->first) * (it_upper->second - it_lower->second) /
+             (it_upper->first - it_lower->first);
+    }
+
+    // Setting values
+
+    void TrajectorySamples::push_back(double t, double y)
+    {
+      assert((m_v_values.empty() || m_v_values.back().first < t) && "time keys must be increasing");
+      m_v_values.emplace_back(t, y);
+      m_version = 0;
+    }
+
+    void TrajectorySamples::erase(double t)
+    {
+      size_t i = search(t, false);
+      if(i < m_v_values.size() && m_v_values[i].first == t)
+        m_v_values.erase(m_v_values.begin() + i);
+      m_version = 0;
+    }
+
+    TrajectorySamples::iterator TrajectorySamples::erase(const_iterator first, const_iterator last)
+    {
+      m_version = 0;
+      return m_v_values.erase(first, last);
+    }
+
+    void TrajectorySamples::shift(double a)
+    {
+      m_version = 0;
+
+      for(auto& it : m_v_values)
+        it.first += a;
+
+      // Rounding may merge close keys
+      m_v_values.erase(
+        unique(m_v_values.begin(), m_v_values.end(),
+          [](const value_type& v1, const value_type& v2) { return v1.first == v2.first; }),
+        m_v_values.end());
+    }
+
+  // Protected methods
+
+    size_t TrajectorySamples::search(double t, bool strict) const
+    {
+      auto before_t = [t,strict](const value_type& v) { return strict ? v.first <= t : v.first < t; };
+
+      const size_t n = m_v_values.size();
+      const_iterator first = m_v_values.begin(), last = m_v_values.end();
+
+      if(n > 2)
+      {
+        const double t0 = m_v_values.front().first, tf = m_v_values.back().first;
+
+        if(t0 < t && t < tf)
+        {
+          // Index guessed from a uniform sampling, and checked:
+          // constant time for uniform samplings, binary search otherwise
+          size_t k = (size_t)((t - t0) / (tf - t0) * (n-1));
+          size_t a = k > 0 ? k-1 : 0, b = min(k+2, n-1);
+
+          if(before_t(m_v_values[a]) && !before_t(m_v_values[b]))
+          {
+            first = m_v_values.begin() + a + 1;
+            last = m_v_values.begin() + b + 1;
+          }
+        }
+      }
+
+      return partition_point(first, last, before_t) - m_v_values.begin();
+    }
+}
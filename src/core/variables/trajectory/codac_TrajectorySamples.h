@@ -0,0 +1,239 @@
+/**
+ *  \file
+ *  TrajectorySamples class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TRAJECTORYSAMPLES_H__
+#define __CODAC_TRAJECTORYSAMPLES_H__
+
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace codac
+{
+  /**
+   * \class TrajectorySamples
+   * \brief Sampled values \f$(t_i,y_i)\f$ of a Trajectory, sorted by time keys
+   *        and stored contiguously.
+   *
+   * The interface is the one of a `std::map<double,double>` (iteration on
+   * pairs `(t,y)`, `find`, `lower_bound`, `operator[]`...), but the values
+   * are stored in one array. Iterations do not involve any indirection, and
+   * appending values in increasing time order is done in amortized constant time.
+   * The search of a time key is in \f$\mathcal{O}(\log n)\f$, and in
+   * \f$\mathcal{O}(1)\f$ for a uniform sampling.
+   *
+   * \note The insertion of a time key in the middle of the samples moves the next values.
+   */
+  class TrajectorySamples
+  {
+    public:
+
+      typedef std::pair<double,double> value_type; //!< pair (t,y) of a sample
+      typedef std::vector<value_type>::iterator iterator; //!< iterator on the samples
+      typedef std::vector<value_type>::const_iterator const_iterator; //!< const iterator on the samples
+      typedef std::vector<value_type>::const_reverse_iterator const_reverse_iterator; //!< const reverse iterator on the samples
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates an empty set of samples
+       */
+      TrajectorySamples();
+
+      /**
+       * \brief Creates the samples from a map of values
+       *
+       * \param map_values map<t,y> of values
+       */
+      explicit TrajectorySamples(const std::map<double,double>& map_values);
+
+      /**
+       * \brief Returns the samples as a map of values
+       *
+       * \return a map<t,y> of values (copy)
+       */
+      std::map<double,double> to_map() const;
+
+      /**
+       * \brief Returns an identifier of the current values
+       *
+       * The identifier changes with any modification of the samples (or any
+       * non-const access to them), and is shared by their copies. It can be
+       * used to detect the changes of the samples, for instance for caching.
+       *
+       * \note Not thread safe, as the identifier is assigned on demand
+       *
+       * \return a non-zero identifier
+       */
+      std::uint64_t version() const;
+
+      /**
+       * \brief Returns the number of samples
+       *
+       * \return number of time keys
+       */
+      std::size_t size() const { return m_v_values.size(); }
+
+      /**
+       * \brief Tests whether there is no sample
+       *
+       * \return true in case of empty samples
+       */
+      bool empty() const { return m_v_values.empty(); }
+
+      /**
+       * \brief Removes all the samples
+       */
+      void clear() { m_v_values.clear(); m_version = 0; }
+
+      /**
+       * \brief Reserves the memory for a given number of samples
+       *
+       * \param n expected number of samples
+       */
+      void reserve(std::size_t n) { m_v_values.reserve(n); }
+
+      /**
+       * \brief Returns a pointer to the samples, stored as contiguous pairs (t,y)
+       *
+       * \note The pointer is invalidated by any insertion of samples (set, append, sample...)
+       *
+       * \return pointer to the first sample
+       */
+      const value_type* data() const { return m_v_values.data(); }
+
+      /// @}
+      /// \name Iterators
+      /// @{
+
+      const_iterator begin() const { return m_v_values.begin(); } //!< first sample
+      const_iterator end() const { return m_v_values.end(); } //!< past-the-end sample
+      const_reverse_iterator rbegin() const { return m_v_values.rbegin(); } //!< last sample
+      const_reverse_iterator rend() const { return m_v_values.rend(); } //!< before-the-first sample
+      iterator begin() { m_version = 0; return m_v_values.begin(); } //!< first sample (the time keys must not be modified)
+      iterator end() { m_version = 0; return m_v_values.end(); } //!< past-the-end sample
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the sample of key \f$t\f$
+       *
+       * \param t the temporal key
+       * \return iterator on the sample, or end() if the key does not exist
+       */
+      const_iterator find(double t) const;
+
+      /**
+       * \brief Returns the first sample of key not less than \f$t\f$
+       *
+       * \param t the temporal key
+       * \return iterator on the sample, or end()
+       */
+      const_iterator lower_bound(double t) const;
+
+      /**
+       * \brief Returns the first sample of key greater than \f$t\f$
+       *
+       * \param t the temporal key
+       * \return iterator on the sample, or end()
+       */
+      const_iterator upper_bound(double t) const;
+
+      /**
+       * \brief Returns the value of key \f$t\f$, that must exist
+       *
+       * \param t the temporal key
+       * \return the value \f$y\f$
+       */
+      double at(double t) const;
+
+      /**
+       * \brief Returns a reference to the value of key \f$t\f$, a new
+       *        sample being inserted if the key does not exist
+       *
+       * \param t the temporal key
+       * \return a reference to the value \f$y\f$
+       */
+      double& operator[](double t);
+
+      /**
+       * \brief Returns the linear interpolation of the samples at \f$t\f$
+       *
+       * \param it_upper first sample of key not less than \f$t\f$ (see lower_bound())
+       * \param t the temporal key, between the first and the last keys
+       * \return the value at \f$t\f$
+       */
+      double interpolate(const_iterator it_upper, double t) const;
+
+      /// @}
+      /// \name Setting values
+      /// @{
+
+      /**
+       * \brief Appends a sample after the last one
+       *
+       * \param t the temporal key, greater than the last one
+       * \param y the value
+       */
+      void push_back(double t, double y);
+
+      /**
+       * \brief Removes the sample of key \f$t\f$, if it exists
+       *
+       * \param t the temporal key
+       */
+      void erase(double t);
+
+      /**
+       * \brief Removes a range of samples
+       *
+       * \param first first sample to be removed
+       * \param last sample following the last one to be removed
+       * \return iterator on the sample following the removed ones
+       */
+      iterator erase(const_iterator first, const_iterator last);
+
+      /**
+       * \brief Shifts the time keys of the samples
+       *
+       * \note If two shifted keys become equal, the first sample is kept
+       *
+       * \param a the offset value so that \f$t_i:=t_i+a\f$
+       */
+      void shift(double a);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Returns the index of the first sample of key not less
+       *        than (or greater than) \f$t\f$
+       *
+       * \param t the temporal key
+       * \param strict if true, the key of the sample must be greater than \f$t\f$
+       * \return index of the sample, or size() if no sample matches
+       */
+      std::size_t search(double t, bool strict) const;
+
+      std::vector<value_type> m_v_values; //!< sorted samples (t,y)
+      mutable std::uint64_t m_version = 0; //!< identifier of the values, 0 if modified since the last call to version()
+  };
+
+  static_assert(sizeof(TrajectorySamples::value_type) == 2*sizeof(double),
+    "samples are expected to be stored as contiguous pairs of doubles");
+}
+
+#endif
@@ -210,8 +210,39 @@ namespace codac
     {
       assert(tdomain().contains(t));
       Vector v(size());
+
+      const Trajectory& x0 = (*this)[0];
+      if(x0.definition_type() != TrajDefnType::MAP_OF_VALUES)
+      {
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = (*this)[i](t);
+        return v;
+      }
+
+      // t is searched once, in the time keys of the first component:
+      // the components sharing these keys are then read at the same index
+      const TrajectorySamples& x0_values = x0.samples();
+      TrajectorySamples::const_iterator it0 = x0_values.lower_bound(t);
+      const size_t k = it0 - x0_values.begin();
+
       for(int i = 0 ; i < size() ; i++)
-        v[i] = (*this)[i](t);
+      {
+        const Trajectory& xi = (*this)[i];
+
+        if(xi.definition_type() == TrajDefnType::MAP_OF_VALUES
+          && xi.samples().size() == x0_values.size())
+        {
+          TrajectorySamples::const_iterator it = xi.samples().begin() + k;
+          if(it->first == it0->first && (it0->first == t || prev(it)->first == prev(it0)->first))
+          {
+            v[i] = xi.samples().interpolate(it, t);
+            continue;
+          }
+        }
+
+        v[i] = xi(t); // different sampling
+      }
+
       return v;
     }
     
@@ -285,6 +316,34 @@ namespace codac
         (*this)[i].set(y[i], t);
     }
 
+    TrajectoryVector& TrajectoryVector::append(const vector<double>& v_t, const vector<Vector>& v_y)
+    {
+      assert(v_t.size() == v_y.size());
+
+      if(v_t.empty())
+        return *this;
+
+      if(m_n == 0)
+      {
+        m_n = v_y.front().size();
+        m_v_trajs = new Trajectory[m_n];
+      }
+
+      vector<double> v_yi(v_y.size());
+      for(int i = 0 ; i < size() ; i++)
+      {
+        for(size_t k = 0 ; k < v_y.size() ; k++)
+        {
+          assert(v_y[k].size() == size());
+          v_yi[k] = v_y[k][i];
+        }
+
+        (*this)[i].append(v_t, v_yi);
+      }
+
+      return *this;
+    }
+
     TrajectoryVector& TrajectoryVector::truncate_tdomain(const Interval& t)
     {
       assert(valid_tdomain(t));
@@ -268,6 +268,18 @@ namespace codac
        */
       void set(const Vector& y, double t);
 
+      /**
+       * \brief Appends values after \f$t_f\f$, in one pass for each component
+       *
+       * \note The components share the time keys, which are searched once
+       *       when evaluating the trajectory
+       *
+       * \param v_t increasing temporal keys, greater than \f$t_f\f$
+       * \param v_y vector values of the trajectory at these keys
+       * \return a reference to this trajectory
+       */
+      TrajectoryVector& append(const std::vector<double>& v_t, const std::vector<Vector>& v_y);
+
       /**
        * \brief Truncates the tdomain of \f$\mathbf{x}(\cdot)\f$
        *
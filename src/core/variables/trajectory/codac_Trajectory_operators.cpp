@@ -23,7 +23,7 @@ namespace codac
         "not supported yet for trajectories defined by a Function"); \
       \
       for(auto& kv : m_map_values) \
-        m_map_values[kv.first] = kv.second f x; \
+        kv.second = kv.second f x; \
       m_codomain.fdef(x); \
       return *this; \
     } \
@@ -38,11 +38,12 @@ namespace codac
       if(definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x_sampled.sample(*this); \
       \
-      map<double,double> new_map; \
-      for(auto const& it : x_sampled.sampled_map()) \
-        new_map[it.first] = (*this)(it.first) f it.second; \
+      TrajectorySamples new_map; \
+      new_map.reserve(x_sampled.samples().size()); \
+      for(auto const& it : x_sampled.samples()) \
+        new_map.push_back(it.first, (*this)(it.first) f it.second); \
       \
-      m_map_values = new_map; \
+      m_map_values = std::move(new_map); \
       compute_codomain(); \
       return *this; \
     } \
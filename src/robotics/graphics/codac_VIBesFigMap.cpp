@@ -434,12 +434,12 @@ namespace codac
         traj_colormap = m_map_trajs[traj].color_map.second;
 
     if((*traj)[index_x].definition_type() == TrajDefnType::MAP_OF_VALUES
-        && (*traj)[index_x].sampled_map().size() != 0)
+        && (*traj)[index_x].samples().size() != 0)
     {
       const Trajectory *displayed_traj_x, *displayed_traj_y;
       Trajectory *temp_displayed_traj_x = nullptr, *temp_displayed_traj_y = nullptr; // possibly used in case of heavy trajectories
 
-      if((*traj)[index_x].sampled_map().size() > m_traj_max_nb_disp_points) // heavy trajectories
+      if((*traj)[index_x].samples().size() > m_traj_max_nb_disp_points) // heavy trajectories
       {
         // Computing a trajectory less discretized
         
@@ -463,11 +463,11 @@ namespace codac
         displayed_traj_y = &(*traj)[index_y];
       }
 
-      typename map<double,double>::const_iterator it_scalar_values_x, it_scalar_values_y;
-      it_scalar_values_x = displayed_traj_x->sampled_map().begin();
-      it_scalar_values_y = displayed_traj_y->sampled_map().begin();
+      TrajectorySamples::const_iterator it_scalar_values_x, it_scalar_values_y;
+      it_scalar_values_x = displayed_traj_x->samples().begin();
+      it_scalar_values_y = displayed_traj_y->samples().begin();
 
-      while(it_scalar_values_x != displayed_traj_x->sampled_map().end())
+      while(it_scalar_values_x != displayed_traj_x->samples().end())
       {
         if(m_restricted_tdomain.contains(it_scalar_values_x->first))
         {
@@ -301,7 +301,7 @@ namespace codac
     traj.set(0., box()[0].lb());
     traj.set(0., box()[0].ub());
     traj.sample(m_precision);
-    const map<double,double> map_values = traj.sampled_map();
+    const TrajectorySamples map_values = traj.samples();
 
     // Detected loops: value set to 1
     for(size_t i = 0 ; i < m_v_detected_loops.size() ; i++)
@@ -309,7 +309,7 @@ namespace codac
       for(int j = 0 ; j < 2 ; j++)
       {
         double t = m_v_detected_loops[i].box()[j].lb();
-        typename map<double,double>::const_iterator it = map_values.lower_bound(t);
+        TrajectorySamples::const_iterator it = map_values.lower_bound(t);
 
         if(it->first != t && it != map_values.begin())
           it--;
@@ -328,7 +328,7 @@ namespace codac
       for(int j = 0 ; j < 2 ; j++)
       {
         double t = m_v_proven_loops[i].box()[j].lb();
-        typename map<double,double>::const_iterator it = map_values.lower_bound(t);
+        TrajectorySamples::const_iterator it = map_values.lower_bound(t);
 
         if(it->first != t && it != map_values.begin())
           it--;
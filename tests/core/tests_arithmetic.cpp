@@ -1,6 +1,7 @@
 #include "catch_interval.hpp"
 #include "codac_tube_arithmetic.h"
 #include "codac_traj_arithmetic.h"
+#include "codac_tube_expr.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -530,6 +531,77 @@ TEST_CASE("Arithmetic on tubes")
     CHECK(ApproxIntv(z[0].codomain()) == Interval::EMPTY_SET); CHECK(ApproxIntv(z[1].codomain()) == a1); CHECK(ApproxIntv(z[2].codomain()) == a2); 
 
   }
+
+  SECTION("Batch evaluation of slices and gates")
+  {
+    Tube x(Interval(0.,4.), 1., Interval(-1.,2.));
+    x.set(Interval(1.), 0.);
+    x.set(Interval(-1.,0.), 2.);
+    x.set(Interval(2.), 4.);
+
+    Tube y = sqr(x);
+    CHECK(y.nb_slices() == 4);
+    CHECK(y(0.) == Interval(1.));
+    CHECK(y(2.) == Interval(0.,1.));
+    CHECK(y(4.) == Interval(4.));
+    CHECK(y(0.5) == Interval(0.,4.));
+
+    // Different slicings
+    Tube z(Interval(0.,4.), 0.5, Interval(1.));
+    y = x + z;
+    CHECK(y.nb_slices() == 8);
+    CHECK(y(2.) == Interval(0.,1.));
+    CHECK(y(4.) == Interval(3.));
+    CHECK(y(3.2) == Interval(0.,3.));
+
+    // Changes reported to the tracked volume
+    y = x;
+    CHECK(y.tracked_volume() == 4.*3. + 3.*2. + 1.); // envelopes and gates
+    y.reset_changed_tdomain();
+    y &= Interval(-1.,1.);
+    CHECK(y.tracked_volume() == 4.*2. + 2.*2. + 1.);
+    CHECK(y.tracked_volume() == Tube(y).tracked_volume());
+    CHECK(y.changed_tdomain() == Interval(0.,4.));
+    y.reset_changed_tdomain();
+    y += 1.;
+    CHECK(y.changed_tdomain().is_empty()); // same volume
+  }
+
+  SECTION("Lazy expressions")
+  {
+    Tube x(Interval(0.,4.), 1., Interval(-1.,2.));
+    x.set(Interval(1.), 0.);
+    Tube v(Interval(0.,4.), 0.5, Interval(0.,1.));
+    Trajectory traj(Interval(0.,4.), TFunction("t"));
+
+    Tube y = lazy(x) + 2*cos(lazy(v)) - lazy(x)*lazy(x);
+    CHECK(y == x + 2.*cos(v) - x*x);
+    CHECK(y.nb_slices() == 8);
+    CHECK(y(0.) == Interval(1.) + 2.*cos(Interval(0.,1.)) - 1.);
+
+    y = sqr(lazy(v) + Interval(-1.,1.)) / lazy(traj);
+    CHECK(y == sqr(v + Interval(-1.,1.)) / traj);
+
+    TubeVector a(Interval(0.,4.), 1., IntervalVector(2, Interval(1.,2.)));
+    TubeVector b = -lazy(a) * lazy(x) + IntervalVector(2, Interval(1.));
+    CHECK(b.size() == 2);
+    CHECK(b == x * (-a) + IntervalVector(2, Interval(1.)));
+
+    Trajectory t1(map<double,double>{{0.,1.},{2.,3.},{4.,0.}});
+    Trajectory t2(map<double,double>{{0.,2.},{1.,2.},{4.,2.}});
+    Trajectory t3 = lazy(t1) * lazy(t2) - 1.;
+    CHECK(t3.sampled_map().size() == 4);
+    CHECK(t3(2.) == 5.);
+    CHECK(t3(1.) == 3.);
+
+    // Trajectories are only evaluated on their common tdomain
+    Trajectory t4(map<double,double>{{1.,1.},{3.,1.}});
+    Trajectory t5 = lazy(t1) + lazy(t4);
+    CHECK(t5.tdomain() == Interval(1.,3.));
+    CHECK(t5.sampled_map().size() == 3);
+    CHECK(t5(1.) == 3.);
+    CHECK(t5(2.) == 4.);
+  }
 }
 
 
@@ -1,6 +1,12 @@
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <iterator>
+#include <algorithm>
 #include "catch_interval.hpp"
 #include "codac_Variable.h"
 #include "codac_ContractorNetwork.h"
+#include "codac_CNSolver.h"
 #include "codac_CtcDeriv.h"
 #include "codac_CtcEval.h"
 #include "codac_CtcFunction.h"
@@ -142,6 +148,30 @@ TEST_CASE("CN simple")
     CHECK(cn.nb_dom() == 12);
   }
 
+  SECTION("Local propagation on a tube")
+  {
+    Interval domain(0.,10.);
+    Tube x(domain, 0.5, Interval(-10.,10.)), v(domain, 0.5, Interval(-1.,1.));
+
+    CtcDeriv ctc_deriv;
+    CtcEval ctc_eval;
+    Interval t(5.), z(0.);
+
+    ContractorNetwork cn;
+    cn.add(ctc_deriv, {x, v});
+    cn.contract();
+    CHECK(x.codomain() == Interval(-10.,10.));
+
+    cn.add(ctc_eval, {t, z, x, v});
+    cn.contract();
+
+    CHECK(cn.nb_ctc_in_stack() == 0);
+    CHECK(x(5.) == Interval(0.));
+    CHECK(x(0.) == Interval(-5.,5.));
+    CHECK(x(10.) == Interval(-5.,5.));
+    CHECK(x(2.) == Interval(-3.,3.));
+  }
+
   SECTION("With f")
   {
     double dt = 5.;
@@ -166,6 +196,430 @@ TEST_CASE("CN simple")
     cn.contract();
   }
 
+  SECTION("Parallel propagation")
+  {
+    CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+    CtcDeriv ctc_deriv;
+    CtcEval ctc_eval;
+
+    const int n = 20;
+    Interval one(1.), t0(0.);
+    vector<Interval> a_seq(n, Interval(-100.,100.)), a_par(a_seq);
+    a_seq[0] = Interval(0.); a_par[0] = Interval(0.);
+    Interval z_seq(0.), z_par(0.);
+    Tube x_seq(Interval(0.,10.), 0.5, Interval(-100.,100.)), v_seq(Interval(0.,10.), 0.5, Interval(1.));
+    Tube x_par(x_seq), v_par(v_seq);
+
+    ContractorNetwork cn_seq, cn_par;
+    cn_par.set_nb_threads(4);
+    CHECK(cn_seq.nb_threads() == 1);
+    CHECK(cn_par.nb_threads() == 4);
+
+    for(int i = 0 ; i < n-1 ; i++)
+    {
+      cn_seq.add(ctc_add, {a_seq[i], one, a_seq[i+1]});
+      cn_par.add(ctc_add, {a_par[i], one, a_par[i+1]});
+    }
+
+    cn_seq.add(ctc_deriv, {x_seq, v_seq});
+    cn_seq.add(ctc_eval, {t0, z_seq, x_seq, v_seq});
+    cn_par.add(ctc_deriv, {x_par, v_par});
+    cn_par.add(ctc_eval, {t0, z_par, x_par, v_par});
+
+    cn_seq.contract();
+    cn_par.contract();
+
+    CHECK(cn_par.nb_ctc_in_stack() == 0);
+    for(int i = 0 ; i < n ; i++)
+    {
+      CHECK(a_seq[i] == Interval(i));
+      CHECK(a_par[i] == a_seq[i]);
+    }
+
+    CHECK(x_seq.codomain() == Interval(0.,10.));
+    CHECK(x_par == x_seq);
+    CHECK(v_par == v_seq);
+  }
+
+  SECTION("Large network")
+  {
+    CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+
+    const int n = 10000;
+    Interval one(1.);
+    vector<Interval> a(n, Interval());
+    a[0] = Interval(0.);
+    IntervalVector b(2, Interval(-1.,1.));
+
+    ContractorNetwork cn;
+    for(int i = 0 ; i < n-1 ; i++)
+    {
+      cn.add(ctc_add, {a[i], one, a[i+1]});
+      cn.add(ctc_add, {a[i], one, a[i+1]}); // redundant contractor that should not be added
+    }
+
+    CtcFunction ctc_sum(Function("b[2]", "c", "b[0]+b[1]-c"));
+    cn.add(ctc_sum, {b, a[1]});
+
+    CHECK(cn.nb_dom() == n+1+3);
+    CHECK(cn.nb_ctc() == n-1+1+1);
+
+    cn.contract();
+
+    CHECK(cn.nb_ctc_in_stack() == 0);
+    CHECK(a[n-1] == Interval(n-1));
+    CHECK(a[n/2] == Interval(n/2));
+    CHECK(b == IntervalVector(2, Interval(0.,1.)));
+  }
+
+  SECTION("Contraction budget")
+  {
+    CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+
+    const int n = 20;
+    Interval one(1.);
+    vector<Interval> a(n, Interval());
+    a[0] = Interval(0.);
+
+    ContractorNetwork cn;
+    for(int i = 0 ; i < n-1 ; i++)
+      cn.add(ctc_add, {a[i], one, a[i+1]});
+
+    ContractionBudget budget;
+    budget.cancellation.cancel();
+    cn.set_budget(budget);
+    cn.contract();
+    CHECK(cn.status() == ContractionStatus::CANCELLED);
+    CHECK(cn.nb_ctc_calls() == 0);
+    CHECK(cn.nb_ctc_in_stack() == n-1);
+
+    budget.cancellation.reset();
+    budget.max_ctc_calls = 5;
+    cn.set_budget(budget);
+    cn.contract();
+    CHECK(cn.status() == ContractionStatus::CALLS_LIMIT);
+    CHECK(cn.nb_ctc_calls() == 5);
+    CHECK(cn.nb_ctc_in_stack() == n-1-5);
+
+    cn.contract_during(0.);
+    CHECK(cn.status() == ContractionStatus::TIME_LIMIT);
+    CHECK(cn.nb_ctc_calls() == 0);
+
+    // Contractions of a[1] are not propagated
+    budget.max_ctc_calls = -1;
+    budget.max_dom_contractions = 0;
+    cn.set_budget(budget);
+    cn.contract();
+    CHECK(cn.status() == ContractionStatus::FIXED_POINT);
+    CHECK(cn.nb_ctc_in_stack() == 0);
+    CHECK(a[1] == Interval(1.));
+    CHECK(a[2] == Interval());
+
+    cn.set_budget(ContractionBudget());
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(cn.status() == ContractionStatus::FIXED_POINT);
+    CHECK(a[n-1] == Interval(n-1));
+  }
+
+  SECTION("Branch-and-prune solver")
+  {
+    CtcFunction ctc_circle(Function("x[2]", "x[0]^2+x[1]^2-1"));
+    IntervalVector x(2, Interval(-2.,2.));
+
+    ContractorNetwork cn;
+    cn.add(ctc_circle, {x});
+
+    CNSolver solver(cn, {x});
+    map<SetValue,list<IntervalVector>> dfs = solver.solve(0.1);
+    int nb_boxes = solver.nb_processed_boxes();
+
+    CHECK(!dfs[SetValue::UNKNOWN].empty());
+    CHECK(x == IntervalVector(2, Interval(-2.,2.))); // network restored after solving
+
+    IntervalVector hull(2, Interval::EMPTY_SET);
+    for(const auto& b : dfs[SetValue::UNKNOWN])
+    {
+      CHECK(b.max_diam() < 0.1);
+      hull |= b;
+    }
+    CHECK(hull.is_subset(IntervalVector(2, Interval(-1.,1.))));
+    CHECK(hull[0].diam() > 1.9);
+
+    for(const auto& b : dfs[SetValue::OUT])
+      CHECK(!b.is_empty());
+
+    // Same paving, whatever the exploration order
+    solver.set_strategy(SearchStrategy::BREADTH_FIRST);
+    CHECK(solver.solve(0.1)[SetValue::UNKNOWN].size() == dfs[SetValue::UNKNOWN].size());
+    CHECK(solver.nb_processed_boxes() == nb_boxes);
+    solver.set_strategy(SearchStrategy::BEST_FIRST);
+    solver.set_priority([](const IntervalVector& b) { return b[0].lb(); });
+    CHECK(solver.solve(0.1)[SetValue::UNKNOWN].size() == dfs[SetValue::UNKNOWN].size());
+
+    // Parallel solving, over two instances of the problem
+    CtcFunction ctc_circle_bis(Function("x[2]", "x[0]^2+x[1]^2-1"));
+    IntervalVector x_bis(x);
+    ContractorNetwork cn_bis;
+    cn_bis.add(ctc_circle_bis, {x_bis});
+
+    solver.set_strategy(SearchStrategy::DEPTH_FIRST);
+    solver.add_instance(cn_bis, {x_bis});
+    CHECK(solver.nb_instances() == 2);
+    CHECK_THROWS(solver.add_instance(cn_bis, {x_bis}));
+
+    map<SetValue,list<IntervalVector>> par = solver.solve(0.1, false);
+    CHECK(par[SetValue::OUT].empty());
+    CHECK(!par[SetValue::UNKNOWN].empty());
+    for(const auto& b : par[SetValue::UNKNOWN])
+      CHECK(b.is_subset(IntervalVector(2, Interval(-1.,1.))));
+    CHECK(x_bis == x);
+
+    // An exception raised by a contractor is rethrown by the solver
+    class CtcThrow : public ibex::Ctc
+    {
+      public:
+        CtcThrow() : ibex::Ctc(2) { }
+        void contract(IntervalVector& b)
+        {
+          if(b.max_diam() < 1.)
+            throw Exception("CtcThrow", "small box");
+        }
+    } ctc_throw, ctc_throw_bis;
+
+    IntervalVector y(2, Interval(-2.,2.)), y_bis(y);
+    ContractorNetwork cn_throw, cn_throw_bis;
+    cn_throw.add(ctc_throw, {y});
+    cn_throw_bis.add(ctc_throw_bis, {y_bis});
+    CNSolver solver_throw(cn_throw, {y});
+    solver_throw.add_instance(cn_throw_bis, {y_bis});
+    CHECK_THROWS(solver_throw.solve(0.1));
+    CHECK(y == IntervalVector(2, Interval(-2.,2.)));
+    CHECK(y_bis == y);
+  }
+
+  SECTION("Checkpoint and restore")
+  {
+    CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+    CtcDeriv ctc_deriv;
+    CtcEval ctc_eval;
+
+    Interval a(0.,10.), b(0.,10.), c(5.);
+    IntervalVector d(2, Interval(-1.,1.));
+    Interval t(5.), z(0.,10.);
+    Tube x(Interval(0.,10.), 1., Interval(-100.,100.)), v(Interval(0.,10.), 1., Interval(-1.,1.));
+
+    ContractorNetwork cn;
+    cn.add(ctc_add, {a, b, c});
+    cn.add(ctc_add, {d[0], d[1], a});
+    cn.add(ctc_deriv, {x, v});
+    cn.add(ctc_eval, {t, z, x, v});
+    CHECK(cn.checkpoint().nb_values() > 0);
+    cn.contract();
+
+    CHECK(a == Interval(0.,2.));
+    CHECK(b == Interval(3.,5.));
+    CHECK(x(5.) == Interval(0.,10.));
+    const Tube x_ref(x);
+    const CNCheckpoint cp = cn.checkpoint();
+
+    // Unchanged values are shared with the previous checkpoint
+    a = Interval(0.,1.5);
+    const CNCheckpoint cp_a = cn.checkpoint();
+    CHECK(cp_a.nb_values() == cp.nb_values());
+    CHECK(cp_a.nb_new_values() == 1);
+    a = Interval(0.,2.);
+
+    // Exploratory contraction
+    z = Interval(1.);
+    a = Interval(0.,1.);
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(b == Interval(4.,5.));
+    CHECK(x(5.) == Interval(1.));
+    CHECK(x(0.) == Interval(-4.,6.));
+
+    cn.restore(cp);
+    CHECK(cn.nb_ctc_in_stack() == 0);
+    CHECK(a == Interval(0.,2.));
+    CHECK(b == Interval(3.,5.));
+    CHECK(z == Interval(0.,10.));
+    CHECK(d == IntervalVector(2, Interval(-1.,1.)));
+    CHECK(x == x_ref);
+
+    ContractorNetwork other_cn;
+    CHECK_THROWS(other_cn.restore(cp));
+    CHECK_THROWS(cn.restore(CNCheckpoint()));
+  }
+
+  SECTION("Static execution plan")
+  {
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    CtcFunction ctc_minus(Function("a", "b", "c", "a-b-c"));
+    Interval a(0.,1.), b(-1.,1.), c(1.5,2.), d(0.,10.), e(-10.,10.);
+
+    ContractorNetwork cn;
+    cn.add(ctc_plus, {a, b, c});
+    cn.add(ctc_minus, {d, c, e});
+
+    CNExecutionPlan plan = cn.compile();
+    CHECK(plan.nb_ctc() == 2);
+    CHECK(plan.nb_dom() == 5);
+    CHECK(plan.run() > 0);
+    CHECK(a == Interval(0.5,1.));
+    CHECK(b == Interval(0.5,1.));
+    CHECK(c == Interval(1.5,2.));
+    CHECK(e == Interval(-2.,8.5));
+
+    // New values, same network
+    a = Interval(0.,1.); b = Interval(0.,2.); c = Interval(2.5,3.);
+    d = Interval(3.); e = Interval(-10.,10.);
+    plan.run();
+    CHECK(a == Interval(0.5,1.));
+    CHECK(b == Interval(1.5,2.));
+    CHECK(e == Interval(0.,0.5));
+
+    // Same fixed point as the propagation of the network
+    a = Interval(0.,1.); b = Interval(0.,2.); c = Interval(2.5,3.);
+    d = Interval(3.); e = Interval(-10.,10.);
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(a == Interval(0.5,1.));
+    CHECK(b == Interval(1.5,2.));
+    CHECK(e == Interval(0.,0.5));
+
+    CHECK(plan.run(1) == 1);
+    CHECK_THROWS(CNExecutionPlan().run());
+
+    Interval f(0.,1.);
+    cn.add(ctc_plus, {e, f, d});
+    CHECK_THROWS(plan.run()); // the network has changed
+  }
+
+  SECTION("Contractor scheduling policies")
+  {
+    CtcFunction ctc_add(Function("a", "b", "c", "a+b-c"));
+    CtcDeriv ctc_deriv;
+    CheapestFirstScheduler cheapest_first;
+    LargestRatioFirstScheduler largest_ratio_first;
+    RoundRobinScheduler round_robin;
+    vector<ContractorScheduler*> v_schedulers = { &cheapest_first, &largest_ratio_first, &round_robin };
+
+    for(auto& scheduler : v_schedulers)
+    {
+      const int n = 10;
+      Interval one(1.);
+      vector<Interval> a(n, Interval(-100.,100.));
+      a[n-1] = Interval(n-1);
+      Tube x(Interval(0.,10.), 1., Interval(-100.,100.)), v(Interval(0.,10.), 1., Interval(-1.,1.));
+      x.set(Interval(0.), 0.);
+
+      ContractorNetwork cn;
+      for(int i = 0 ; i < n-1 ; i++)
+        cn.add(ctc_add, {a[i], one, a[i+1]});
+      cn.add(ctc_deriv, {x, v});
+
+      CHECK(cn.scheduler() == nullptr);
+      int nb_ctc = cn.nb_ctc_in_stack();
+      cn.set_scheduler(scheduler);
+      CHECK(cn.scheduler() == scheduler);
+      CHECK(cn.nb_ctc_in_stack() == nb_ctc);
+      CHECK_THROWS(cn.contract_ordered_mode());
+
+      cn.contract();
+      CHECK(cn.nb_ctc_in_stack() == 0);
+
+      for(int i = 0 ; i < n ; i++)
+        CHECK(a[i] == Interval(i));
+      CHECK(x(10.) == Interval(-10.,10.));
+      CHECK(x(3.) == Interval(-3.,3.));
+    }
+
+    CHECK(cheapest_first.cost(nullptr) == 0.);
+  }
+
+  SECTION("Profiling")
+  {
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    CtcFunction ctc_minus(Function("a", "b", "c", "a-b-c"));
+    Interval a(0,1), b(-1,1), c(1.5,2), d(-10,10);
+
+    ContractorNetwork cn;
+    cn.add(ctc_plus, {a, b, c});
+    cn.add(ctc_minus, {a, b, d});
+    cn.set_name(ctc_plus, "+");
+    cn.set_name(ctc_minus, "-");
+    CHECK(!cn.profiling());
+
+    cn.set_profiling(true);
+    CHECK(cn.profiling());
+    cn.contract();
+
+    vector<ContractorProfile> v_profiles = cn.profiling_report();
+    CHECK(v_profiles.size() == 2);
+    for(size_t i = 0 ; i < v_profiles.size() ; i++)
+    {
+      CHECK(v_profiles[i].nb_calls >= 1);
+      CHECK(v_profiles[i].time >= 0.);
+      if(i > 0)
+        CHECK(v_profiles[i-1].time >= v_profiles[i].time);
+
+      if(v_profiles[i].name == "+")
+      {
+        CHECK(v_profiles[i].nb_contractions >= 1);
+        CHECK(v_profiles[i].volume_reduction == Approx(2.)); // a: [0,1] to [0.5,1], b: [-1,1] to [0.5,1]
+      }
+    }
+
+    cn.export_profiling_csv("cn_profiling.csv");
+    {
+      ifstream file("cn_profiling.csv");
+      REQUIRE(file.is_open());
+      string line;
+      getline(file, line);
+      CHECK(line == "id,name,nb_calls,nb_contractions,time,volume_reduction");
+
+      size_t nb_rows = 0;
+      while(getline(file, line))
+      {
+        // Six fields, the name being quoted
+        CHECK(count(line.begin(), line.end(), ',') == 5);
+        CHECK(line.find(",\"") != string::npos);
+        istringstream row(line);
+        string id;
+        getline(row, id, ',');
+        REQUIRE(nb_rows < v_profiles.size());
+        CHECK(stoi(id) == v_profiles[nb_rows].ctc_id);
+        nb_rows++;
+      }
+      CHECK(nb_rows == v_profiles.size());
+    }
+    CHECK(remove("cn_profiling.csv") == 0);
+
+    cn.export_profiling_json("cn_profiling.json");
+    {
+      ifstream file("cn_profiling.json");
+      REQUIRE(file.is_open());
+      string json((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+      CHECK(json.find_first_not_of(" \n") == json.find('['));
+      CHECK(json.find_last_not_of(" \n") == json.rfind(']'));
+      CHECK(count(json.begin(), json.end(), '{') == (int)v_profiles.size());
+      CHECK(count(json.begin(), json.end(), '}') == (int)v_profiles.size());
+      for(const auto& p : v_profiles)
+        CHECK(json.find("\"name\": \"" + p.name + "\"") != string::npos);
+    }
+    CHECK(remove("cn_profiling.json") == 0);
+
+    cn.print_dot_graph("cn_profiling", "fdp", true);
+
+    cn.reset_profiling();
+    for(const auto& p : cn.profiling_report())
+    {
+      CHECK(p.nb_calls == 0);
+      CHECK(p.time == 0.);
+    }
+  }
+
   SECTION("CtcFunction on scalar or vector cases")
   {
     CtcFunction ctc_add(Function("b", "c", "a", "b+c-a"));
@@ -9,6 +9,7 @@
 #include "codac_predef_values.h"
 #include "codac2_Tube.h"
 #include "codac2_CtcDiffInclusion.h"
+#include "codac_CtcDeriv.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -128,6 +129,30 @@ TEST_CASE("Test codac2::tubes")
     CHECK(vector_tslices[3].t0_tf() == Interval(10,oo));
   }
 
+  SECTION("Test TDomain index after sampling and deleting gates")
+  {
+    auto tdomain = create_tdomain(Interval(0,1), 0.25, true);
+    tdomain->sample(-1., true); // before t0
+    tdomain->sample(2., false); // after tf
+    tdomain->sample(0.6, true);
+    CHECK(tdomain->nb_tslices() == 14);
+    CHECK(tdomain->iterator_tslice(-1.)->t0_tf() == Interval(-1));
+    CHECK(tdomain->iterator_tslice(-0.5)->t0_tf() == Interval(-1,0));
+    CHECK(tdomain->iterator_tslice(0.)->t0_tf() == Interval(0));
+    CHECK(tdomain->iterator_tslice(0.6)->t0_tf() == Interval(0.6));
+    CHECK(tdomain->iterator_tslice(0.7)->t0_tf() == Interval(0.6,0.75));
+    CHECK(tdomain->iterator_tslice(1.)->t0_tf() == Interval(1));
+    CHECK(tdomain->iterator_tslice(1.5)->t0_tf() == Interval(1,2));
+    CHECK(tdomain->iterator_tslice(2.)->t0_tf() == Interval(1,2));
+
+    tdomain->delete_gates();
+    CHECK(tdomain->nb_tslices() == 7);
+    CHECK(tdomain->iterator_tslice(-1.)->t0_tf() == Interval(-1,0));
+    CHECK(tdomain->iterator_tslice(0.)->t0_tf() == Interval(0,0.25));
+    CHECK(tdomain->iterator_tslice(0.6)->t0_tf() == Interval(0.6,0.75));
+    CHECK(tdomain->iterator_tslice(1.)->t0_tf() == Interval(1,2));
+  }
+
   SECTION("Test unbounded TDomain")
   {
     auto tdomain = create_tdomain();
@@ -187,19 +212,19 @@ TEST_CASE("Test codac2::tubes")
     CHECK(static_cast<IntervalVector>(x(3.)) == IntervalVector({{6,9}}));
     CHECK(static_cast<IntervalVector>(x(999.)) == IntervalVector(1));
     
-    const std::shared_ptr<Slice<IntervalVector>> s0 = x.first_slice_ptr();
+    const Slice<IntervalVector>* s0 = x.first_slice_ptr();
     CHECK(s0->t0_tf() == Interval(-oo,0));
     CHECK(s0->codomain() == IntervalVector({{-oo,oo}}));
-    const std::shared_ptr<Slice<IntervalVector>> s1 = s0->next_slice_ptr();
+    const Slice<IntervalVector>* s1 = s0->next_slice_ptr();
     CHECK(s1->t0_tf() == Interval(0,1));
     CHECK(s1->codomain() == IntervalVector({{1,5}}));
-    const std::shared_ptr<Slice<IntervalVector>> s2 = s1->next_slice_ptr();
+    const Slice<IntervalVector>* s2 = s1->next_slice_ptr();
     CHECK(s2->t0_tf() == Interval(1,2));
     CHECK(s2->codomain() == IntervalVector({{2,8}}));
-    const std::shared_ptr<Slice<IntervalVector>> s3 = s2->next_slice_ptr();
+    const Slice<IntervalVector>* s3 = s2->next_slice_ptr();
     CHECK(s3->t0_tf() == Interval(2,3));
     CHECK(s3->codomain() == IntervalVector({{6,9}}));
-    const std::shared_ptr<Slice<IntervalVector>> s4 = s3->next_slice_ptr();
+    const Slice<IntervalVector>* s4 = s3->next_slice_ptr();
     CHECK(s4->t0_tf() == Interval(3,oo));
     CHECK(s4->codomain() == IntervalVector({{-oo,oo}}));
 
@@ -208,7 +233,7 @@ TEST_CASE("Test codac2::tubes")
     CHECK(tdomain->nb_tslices() == 6);
     CHECK(s2->t0_tf() == Interval(1,1.3));
     CHECK(s2->codomain() == IntervalVector({{2,8}}));
-    const std::shared_ptr<Slice<IntervalVector>> s2bis = s2->next_slice_ptr();
+    const Slice<IntervalVector>* s2bis = s2->next_slice_ptr();
     CHECK(s2bis->t0_tf() == Interval(1.3,2));
     CHECK(s2bis->codomain() == IntervalVector({{2,8}}));
     CHECK(s3->t0_tf() == Interval(2,3));
@@ -344,7 +369,7 @@ TEST_CASE("Test codac2::tubes")
 
     // Iterators tests
     {
-      shared_ptr<Slice<IntervalVector>> s_ = x.first_slice_ptr();
+      const Slice<IntervalVector>* s_ = x.first_slice_ptr();
       for(auto& s : x)
       {
         CHECK(&s == &(*s_));
@@ -355,7 +380,7 @@ TEST_CASE("Test codac2::tubes")
     // Iterators tests (const)
     {
       const Tube<IntervalVector> y(x); // copy constructor
-      shared_ptr<Slice<IntervalVector>> s_ = x.first_slice_ptr();
+      const Slice<IntervalVector>* s_ = x.first_slice_ptr();
       for(const auto& s : x)
       {
         CHECK(&s == &(*s_));
@@ -364,6 +389,52 @@ TEST_CASE("Test codac2::tubes")
     }
   }
 
+  SECTION("Test slots of tubes")
+  {
+    auto tdomain = create_tdomain(Interval(0,1), 0.1);
+    Tube<Interval> x(tdomain, Interval(-1,1));
+    CHECK(tdomain->nb_tubes() == 1);
+
+    size_t slot_y;
+    {
+      Tube<Interval> y(tdomain, Interval(2));
+      slot_y = y.slot();
+      CHECK(tdomain->nb_tubes() == 2);
+      CHECK(x.slot() != y.slot());
+      tdomain->sample(0.55, true);
+      CHECK(y.eval(0.55) == Interval(2));
+      CHECK(y.nb_slices() == 12);
+    }
+
+    CHECK(tdomain->nb_tubes() == 1);
+    Tube<Interval> z(x);
+    CHECK(z.slot() == slot_y); // the slot has been reused
+    CHECK(z == x);
+    CHECK(z.eval(0.55) == Interval(-1,1));
+    CHECK(tdomain->tslices().front().slices().size() == 2);
+  }
+
+  SECTION("Test slices from the pool of the TDomain")
+  {
+    auto tdomain = create_tdomain(Interval(0,1), 0.125, true);
+    Tube<IntervalVector> x(tdomain, IntervalVector(2,Interval(-1,1)));
+    const Slice<IntervalVector>* s = x.first_slice_ptr();
+
+    {
+      Tube<Interval> y(tdomain, Interval(0,2));
+      tdomain->sample(0.5625, true); // duplicated slices
+      CHECK(x.nb_slices() == 19);
+      CHECK(x.eval(0.5625) == IntervalVector(2,Interval(-1,1)));
+      CHECK(y.eval(0.5625) == Interval(0,2));
+    }
+
+    // The slices of x are not moved by the sampling, nor by the destruction of y
+    CHECK(x.first_slice_ptr() == s);
+    CHECK(s->codomain() == IntervalVector(2,Interval(-1,1)));
+    Tube<Interval> z(tdomain, Interval(3));
+    CHECK(z.eval(0.5625) == Interval(3));
+  }
+
   SECTION("Test SliceVector")
   {
     auto tdomain = create_tdomain(Interval(0,1), 0.1);
@@ -371,8 +442,8 @@ TEST_CASE("Test codac2::tubes")
     CHECK(x.nb_slices() == 10);
     CHECK(tdomain->iterator_tslice(-oo) == tdomain->_tslices.end());
     CHECK(tdomain->iterator_tslice(oo) == tdomain->_tslices.end());
-    CHECK(x.first_slice_ptr() == tdomain->iterator_tslice(0.)->_slices.at(&x));
-    CHECK(x.last_slice_ptr() == tdomain->iterator_tslice(1.)->_slices.at(&x));
+    CHECK(x.first_slice_ptr() == tdomain->iterator_tslice(0.)->slice(x));
+    CHECK(x.last_slice_ptr() == tdomain->iterator_tslice(1.)->slice(x));
 
     for(auto& s : x)
       s.set(IntervalVector(2,s.t0_tf()));
@@ -606,4 +677,40 @@ TEST_CASE("Test codac2::tubes")
     CHECK(ApproxIntv(tdomain->iterator_tslice(2.)->t0_tf()) == Interval(1.900000000000001, 2.000000000000002));
     CHECK(ApproxIntv(a.eval(Interval(1,2))) == Interval(-2.26146836547144, 7.216099682706644));
   }
-}
\ No newline at end of file
+
+  SECTION("Native CtcDeriv on codac2 tubes")
+  {
+    auto tdomain = create_tdomain(Interval(0,10), 0.5, true); // with gates
+    Tube<Interval> x(tdomain, Interval(-20.,20.));
+    Tube<Interval> v(tdomain, Interval(1.));
+    x.set(Interval(0.), 0.);
+    x.set(Interval(4.,4.5), 4.);
+
+    codac::CtcDeriv ctc_deriv;
+    ctc_deriv.contract(x, v);
+    CHECK(ApproxIntv(x.eval(10.)) == Interval(10.));
+    CHECK(ApproxIntv(x.eval(Interval(2.,2.5))) == Interval(2.,2.5));
+
+    // Same contraction rule as on codac1 tubes
+    codac::Tube x1(Interval(0,10), 0.5, Interval(-20.,20.));
+    x1.set(Interval(0.), 0.);
+    x1.set(Interval(4.,4.5), 4.);
+    ctc_deriv.contract(x1, codac::Tube(Interval(0,10), 0.5, Interval(1.)));
+
+    for(const auto& s : x)
+    {
+      if(s.is_gate())
+        CHECK(s.codomain() == x1(s.t0_tf().lb()));
+      else
+        CHECK(s.codomain() == x1.slice(x1.time_to_index(s.t0_tf().mid()))->codomain());
+    }
+
+    Tube<IntervalVector> xv(tdomain, IntervalVector(2, Interval(-20.,20.)));
+    xv.set(IntervalVector({Interval(0.),Interval(1.)}), 0.);
+    for(auto& s : xv)
+      s.set_component(1, Interval(1.));
+    ctc_deriv.contract(xv);
+    CHECK(ApproxIntv(xv.eval(10.)[0]) == Interval(10.));
+    CHECK(xv.eval(10.)[1] == Interval(1.));
+  }
+}
@@ -365,6 +365,44 @@ TEST_CASE("CtcDeriv")
     #endif
   }
 
+  SECTION("Test parallel fwd/bwd")
+  {
+    Tube x(Interval(0.,10.), 0.001);
+    Tube v(Interval(0.,10.), 0.001, TFunction("cos(t)+[-0.1,0.1]"));
+    x.set(Interval(-1.,1.), 0.);
+    x.set(Interval(0.,0.5), 5.);
+    x.set(Interval(-2.,2.), 10.);
+    x.set(Interval(-0.5,3.), Interval(2.,3.));
+    v.sample(x); // same slicing, with the gates added at t=2, t=3 and t=5
+    REQUIRE(Tube::same_slicing(x, v));
+
+    for(TimePropag t_propa : { TimePropag::FORWARD, TimePropag::BACKWARD, TimePropag::FORWARD | TimePropag::BACKWARD })
+    {
+      Tube x_seq(x), x_par(x);
+
+      CtcDeriv ctc_seq;
+      ctc_seq.contract(x_seq, v, t_propa);
+
+      CtcDeriv ctc_par;
+      ctc_par.set_nb_threads(4);
+      CHECK(ctc_par.nb_threads() == 4);
+      ctc_par.contract(x_par, v, t_propa);
+
+      CHECK(x_par == x_seq);
+    }
+
+    TubeVector xv(3, x), vv(3, v);
+    xv[1].set(Interval(1.,2.), 8.);
+    vv[1].sample(xv[1]);
+    TubeVector xv_seq(xv);
+
+    CtcDeriv ctc;
+    ctc.contract(xv_seq, vv);
+    ctc.set_nb_threads(2);
+    ctc.contract(xv, vv);
+    CHECK(xv == xv_seq);
+  }
+
   SECTION("From: Test slice, output gate contraction")
   {
     Slice x(Interval(-1.,3.), Interval(-5.,3.));
@@ -1325,6 +1325,27 @@ TEST_CASE("CtcEval (other tests)")
     }
   }
 
+  SECTION("Test CtcEval, unbounded outside [t] with propagation")
+  {
+    Tube x(Interval(0.,10.), 1.);
+    Tube v(Interval(0.,10.), 1., Interval(-1.,1.));
+    Interval t(4.5,5.5), z(0.,POS_INFINITY);
+
+    CtcEval ctc_eval; // propagation enabled
+    ctc_eval.contract(t, z, x, v);
+
+    // The bounded values used during the contraction do not remain in the tube
+    for(const Slice *s = x.first_slice() ; s ; s = s->next_slice())
+    {
+      CHECK(s->input_gate().ub() == POS_INFINITY);
+      CHECK(s->codomain().ub() == POS_INFINITY);
+      CHECK(s->output_gate().ub() == POS_INFINITY);
+    }
+
+    CHECK(x(2.).lb() > NEG_INFINITY); // lower bounds propagated from z
+    CHECK(x(8.).lb() > NEG_INFINITY);
+  }
+
   SECTION("Test CtcEval, dependency on t")
   {
     double dt = 0.1;
@@ -43,6 +43,34 @@ TEST_CASE("CtcStatic")
     CHECK(x[0] == expected);
     CHECK(x[1] == expected);
   }
+
+  SECTION("Test parallel CtcStatic")
+  {
+    Interval tdomain(0., 10.);
+    TubeVector x(tdomain, 0.01, TFunction("(t+[-0.5,0.5] ; 2*t+[-1,1])"));
+    x.set(IntervalVector(2, Interval(-1.,1.)), 0.);
+    TubeVector x_seq(x);
+
+    CtcFunction ctc_f(Function("t", "x[2]", "(x[0]-t+[-0.1,0.1] ; x[1]-x[0]-t)"));
+    CtcStatic ctc_static(ctc_f, true);
+    ctc_static.restrict_tdomain(Interval(2.,8.));
+    ctc_static.contract(x_seq);
+
+    ctc_static.set_nb_threads(4);
+    CHECK(ctc_static.nb_threads() == 4);
+    ctc_static.contract(x);
+    CHECK(x == x_seq);
+
+    CtcStatic ctc_static_factory(ctc_f, true);
+    ctc_static_factory.set_nb_threads(3, []() {
+      return new CtcFunction(Function("t", "x[2]", "(x[0]-t+[-0.1,0.1] ; x[1]-x[0]-t)"));
+    });
+    ctc_static_factory.restrict_tdomain(Interval(2.,8.));
+    TubeVector x_factory(tdomain, 0.01, TFunction("(t+[-0.5,0.5] ; 2*t+[-1,1])"));
+    x_factory.set(IntervalVector(2, Interval(-1.,1.)), 0.);
+    ctc_static_factory.contract(x_factory);
+    CHECK(x_factory == x_seq);
+  }
 }
 
 TEST_CASE("CtcFunction")
@@ -57,4 +85,23 @@ TEST_CASE("CtcFunction")
     ctc_max.contract(tube);
     CHECK(tube[2].codomain() == Interval(4,5));
   }
+
+  SECTION("Test parallel contraction of tubes")
+  {
+    CtcFunction ctc_f(Function("x1", "x2", "x3", "x1+x2-x3"));
+    TubeVector x(Interval(0,10), 0.01, 3);
+    x[0] = Tube(Interval(0,10), 0.01, TFunction("cos(t)+[-0.1,0.1]"));
+    x[1] = Tube(Interval(0,10), 0.01, TFunction("sin(t)+[-0.2,0.2]"));
+    x[2].set(Interval(-0.5,0.5));
+    x.sample(5.); // same slicing for all the components
+    x[2].set(Interval(0.), 5.);
+    REQUIRE(Tube::same_slicing(x[0], x[2]));
+    TubeVector x_seq(x);
+    ctc_f.contract(x_seq);
+
+    ctc_f.set_nb_threads(4);
+    CHECK(ctc_f.nb_threads() == 4);
+    ctc_f.contract(x);
+    CHECK(x == x_seq);
+  }
 }
\ No newline at end of file
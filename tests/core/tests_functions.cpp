@@ -70,4 +70,21 @@ TEST_CASE("Functions")
     CHECK(f.expr(1) == "cos(x2[2])+x1");
     CHECK(f.expr(2) == "x2[1]");
   }
+
+  SECTION("Multi-threaded evaluation on tubes")
+  {
+    TubeVector x(Interval(0.,10.), 0.001, TFunction("(sin(t)+[-0.01,0.01] ; cos(t))"));
+    TFunction f("x1", "x2", "(t/10.+x1*x2 ; exp(x2))");
+    TubeVector y1 = f.eval_vector(x);
+
+    f.set_nb_threads(4);
+    CHECK(f.nb_threads() == 4);
+    TubeVector y2 = f.eval_vector(x);
+    CHECK(y1 == y2);
+
+    TFunction g("t/10.+sin(t)");
+    g.set_nb_threads(0);
+    CHECK(g.nb_threads() >= 1);
+    CHECK(TubeVector(Interval(0.,10.), 0.001, g) == TubeVector(Interval(0.,10.), 0.001, TFunction("t/10.+sin(t)")));
+  }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <cstdio>
+#include <fstream>
+#include <iterator>
 #include "codac_serialize_trajectories.h"
 #include "codac_serialize_tubes.h"
+#include "codac_MappedTube.h"
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
 
@@ -104,6 +107,72 @@ TEST_CASE("serialization/deserialization of Tube")
     CHECK(tube2(3.) == Interval(2.,3.));
   }
 
+  SECTION("Version 2 (backward compatibility)")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::EMPTY_SET, 46.);
+
+    string filename = "test_serialization_v2.tube";
+    tube1.serialize(filename, 2);
+    Tube tube2(filename);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(tube2(46.) == Interval::EMPTY_SET);
+  }
+
+  SECTION("Mapped tube")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval(2.,3.), 3.);
+    tube1.set(Interval::EMPTY_SET, 46.);
+
+    string filename = "test_serialization_mapped.tube";
+    tube1.serialize(filename);
+
+    {
+      MappedTube tube2(filename);
+      CHECK(tube2.nb_slices() == tube1.nb_slices());
+      CHECK(tube2.tdomain() == tube1.tdomain());
+      CHECK(tube2.codomain() == tube1.codomain());
+      CHECK(tube2(3.) == Interval(2.,3.));
+      CHECK(tube2(46.) == Interval::EMPTY_SET);
+      for(int i = 0 ; i < tube1.nb_slices() ; i++)
+      {
+        CHECK(tube2(i) == tube1(i));
+        CHECK(tube2.slice_tdomain(i) == tube1.slice(i)->tdomain());
+        CHECK(tube2.input_gate(i) == tube1.slice(i)->input_gate());
+        CHECK(tube2.time_to_index(tube1.slice(i)->tdomain().mid()) == i);
+      }
+      CHECK(tube2.to_tube() == tube1);
+    }
+
+    tube1.serialize(filename, 2);
+    CHECK_THROWS(MappedTube tube3(filename););
+    remove(filename.c_str());
+
+    Tube tube4(Interval(0.,11.), 0.02);
+    tube4.serialize(filename);
+    Tube tube5(filename);
+    remove(filename.c_str());
+    CHECK(tube5 == tube4);
+    CHECK(tube5.timestep() == tube4.timestep());
+
+    // Truncated file: the header announces more data than available
+    tube4.serialize(filename);
+    string content;
+    {
+      ifstream in(filename, ios::binary);
+      content.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    {
+      ofstream out(filename, ios::binary | ios::trunc);
+      out.write(content.data(), content.size() / 2);
+    }
+    CHECK_THROWS(Tube tube6(filename););
+    CHECK_THROWS(MappedTube tube7(filename););
+    remove(filename.c_str());
+  }
+
   SECTION("With trajectories")
   {
     Tube tube1 = tube_test_1();
@@ -1,5 +1,6 @@
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
+#include "codac_SlabAllocator.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -55,6 +56,69 @@ TEST_CASE("time_to_index")
     CHECK(tube.index(tube.first_slice()) == 0);
     CHECK(tube.index(tube.last_slice()) == 45);
   }
+
+  SECTION("Time index updated by sample and remove_gate")
+  {
+    Tube tube(Interval(0.,1000.), 1.);
+    CHECK(tube.nb_slices() == 1000);
+    CHECK(tube.time_to_index(500.5) == 500);
+
+    tube.sample(500.5);
+    tube.sample(0.25);
+    CHECK(tube.nb_slices() == 1002);
+    CHECK(tube.time_to_index(0.2) == 0);
+    CHECK(tube.time_to_index(0.3) == 1);
+    CHECK(tube.time_to_index(500.7) == 502);
+    CHECK(tube.slice(500.2)->tdomain() == Interval(500.,500.5));
+    CHECK(tube.slice(502)->tdomain() == Interval(500.5,501.));
+    CHECK(tube.last_slice()->tdomain() == Interval(999.,1000.));
+
+    tube.remove_gate(500.);
+    tube.remove_gate(1.);
+    CHECK(tube.nb_slices() == 1000);
+    CHECK(tube.slice(0.5)->tdomain() == Interval(0.25,2.));
+    CHECK(tube.slice(500.2)->tdomain() == Interval(499.,500.5));
+    CHECK(tube.index(tube.slice(500.2)) == 499);
+
+    // The index is built again after other changes of the structure
+    tube.truncate_tdomain(Interval(100.,200.));
+    CHECK(tube.nb_slices() == 100);
+    CHECK(tube.time_to_index(150.5) == 50);
+    tube.shift_tdomain(-100.);
+    CHECK(tube.time_to_index(50.5) == 50);
+    CHECK(tube.slice(50.5)->tdomain() == Interval(50.,51.));
+  }
+
+  SECTION("Uniform slicing")
+  {
+    Tube x(Interval(0.,10.), 0.1);
+    CHECK(x.timestep() == 0.1);
+    CHECK(x.nb_slices() == 100);
+    CHECK(Tube(Interval(0.,10.), Interval(1.)).timestep() == 10.);
+    CHECK(Tube(Interval(0.,10.), 3.).slice(9.5)->tdomain() == Interval(9.,10.));
+
+    // Same indexes as the ones of a generic slicing
+    Tube y(x);
+    CHECK(y.timestep() == 0.1);
+    CHECK(Tube::same_slicing(x, y));
+    y.sample(0.05);
+    CHECK(y.timestep() == 0.);
+    CHECK(!Tube::same_slicing(x, y));
+    for(int i = 1 ; i < 100 ; i++)
+    {
+      const double t = x.slice(i)->tdomain().lb(); // gate, belonging to the next slice
+      CHECK(x.time_to_index(t) == i);
+      CHECK(x.time_to_index(t) == y.time_to_index(t) - 1);
+      CHECK(x.time_to_index(ibex::previous_float(t)) == i-1);
+    }
+    CHECK(x.time_to_index(10.) == 99);
+
+    // Sampling on the grid has no effect
+    x.sample(x.slice(42)->tdomain().lb());
+    CHECK(x.timestep() == 0.1);
+    x.shift_tdomain(1.);
+    CHECK(x.timestep() == 0.);
+  }
 }
 
 TEST_CASE("Tube slices structure")
@@ -415,3 +479,48 @@ TEST_CASE("Tube slices structure")
     CHECK(tube[0].slice(2)->tdomain() == Interval(5.,6.));
   }
 }
+
+TEST_CASE("Slices storage")
+{
+  SECTION("Slab allocator")
+  {
+    SlabAllocator<Interval> allocator(4, 8);
+    CHECK(allocator.capacity() == 0);
+
+    Interval *a = static_cast<Interval*>(allocator.allocate());
+    Interval *b = static_cast<Interval*>(allocator.allocate());
+    Interval *c = static_cast<Interval*>(allocator.allocate());
+    CHECK(allocator.capacity() == 4);
+    CHECK(b == a+1); // contiguous storage
+    CHECK(c == b+1);
+
+    allocator.deallocate(b);
+    CHECK(allocator.allocate() == b); // recycled block
+
+    for(int i = 0 ; i < 5 ; i++)
+      allocator.allocate();
+    CHECK(allocator.capacity() == 12);
+    allocator.deallocate(a);
+    allocator.deallocate(c);
+  }
+
+  SECTION("Stable slices")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-1.,1.));
+    Slice *s = x.slice(2);
+    x.sample(0.5);
+    x.sample(5.5);
+    CHECK(x.nb_slices() == 12);
+    CHECK(x.slice(3) == s);
+    CHECK(s->tdomain() == Interval(2.,3.));
+    CHECK(s->output_gate() == Interval(-1.,1.));
+    x.remove_gate(0.5);
+    CHECK(x.slice(2) == s);
+
+    Tube y(x);
+    CHECK(y == x);
+    y.set(Interval(2.), 2.5);
+    CHECK(x(2.5) == Interval(-1.,1.));
+    CHECK(y(2.5) == Interval(2.));
+  }
+}
@@ -184,4 +184,66 @@ TEST_CASE("Trajectory base")
     CHECK(test1 == test2);
     CHECK(test1[0] == test2[0]);
   }
-}
\ No newline at end of file
+
+  SECTION("Sorted samples")
+  {
+    Trajectory x;
+    x.set(2., 1.);
+    x.set(0., 0.); // insertion before the first key
+    x.append({2.,3.,4.}, {4.,6.,8.});
+    CHECK(x.tdomain() == Interval(0.,4.));
+    CHECK(x.codomain() == Interval(0.,8.));
+    CHECK(x.samples().size() == 5);
+    CHECK(x.samples().begin()->first == 0.);
+    CHECK(x(3.) == 6.);
+    CHECK(Approx(x(3.5)) == 7.);
+    CHECK(x(Interval(0.5,2.5)) == Interval(1.,5.));
+
+    x.set(1., 3.); // existing key
+    CHECK(x(3.) == 1.);
+    CHECK(x.samples().size() == 5);
+
+    x.sample(0.25);
+    CHECK(x.samples().size() == 17);
+    CHECK(x(3.) == 1.);
+    CHECK(Approx(x(3.25)) == 2.75);
+
+    x.shift_tdomain(1.);
+    CHECK(x.tdomain() == Interval(1.,5.));
+    CHECK(x(4.) == 1.);
+    x.truncate_tdomain(Interval(2.,4.5));
+    CHECK(x.samples().size() == 11);
+    CHECK(x.samples().rbegin()->first == 4.5);
+
+    // Deprecated accessor to a map, following the changes of the values
+    const map<double,double>& m = x.sampled_map();
+    CHECK(m.size() == 11);
+    CHECK(m.at(4.) == x(4.));
+    x.set(0., 4.5);
+    CHECK(x.sampled_map().at(4.5) == 0.);
+  }
+
+  SECTION("Trajectory vector with shared time keys")
+  {
+    TrajectoryVector x(2);
+    x.append({0.,1.,2.,4.}, {Vector({0.,1.}), Vector({1.,2.}), Vector({2.,4.}), Vector({0.,0.})});
+    CHECK(x.tdomain() == Interval(0.,4.));
+    CHECK(x(1.) == Vector({1.,2.}));
+    CHECK(x(1.5) == Vector({1.5,3.}));
+    CHECK(x(3.) == Vector({1.,2.}));
+
+    // Component with a different sampling
+    x[1].set(10.,0.5);
+    CHECK(x(0.5) == Vector({0.5,10.}));
+    CHECK(x(1.5) == Vector({1.5,3.}));
+    CHECK(x(3.) == Vector({1.,2.}));
+
+    Matrix m(1,2);
+    m[0][0] = 1.; m[0][1] = 1.;
+    TrajectoryVector y = m*x;
+    CHECK(y.size() == 1);
+    CHECK(y[0].sampled_map().size() == 5);
+    CHECK(y(0.5) == Vector(1,10.5));
+    CHECK(y(3.) == Vector(1,3.));
+  }
+}
@@ -825,6 +825,53 @@ TEST_CASE("Testing volume()")
     CHECK_FALSE(bounded_tube.codomain().is_unbounded());
     CHECK(Approx(bounded_tube.volume()) == 20.);
   }
+
+  SECTION("Tube tracked volume")
+  {
+    Tube x(Interval(0.,4.), 1., Interval(0.,2.));
+    CHECK(x.changed_tdomain() == Interval(0.,4.));
+    CHECK(x.tracked_volume() == 4.*2. + 5.*2.); // envelopes and gates
+    CHECK(x.changed_tdomain() == Interval(0.,4.));
+    x.reset_changed_tdomain();
+    CHECK(x.changed_tdomain().is_empty());
+
+    x.slice(1)->set_envelope(Interval(0.,1.)); // gates are also contracted
+    CHECK(x.tracked_volume() == 18. - 3.*1.);
+    CHECK(x.changed_tdomain() == Interval(1.,2.));
+    x.reset_changed_tdomain();
+
+    x.set(Interval(1.), 4.);
+    CHECK(x.tracked_volume() == 15. - 2.);
+    CHECK(x.tracked_volume() == Tube(x).tracked_volume());
+    CHECK(x.changed_tdomain() == Interval(3.,4.));
+
+    x.sample(0.5);
+    CHECK(x.nb_slices() == 5);
+    CHECK(x.tracked_volume() == 13. + 2.);
+    CHECK(x.tracked_volume() == Tube(x).tracked_volume());
+    CHECK(x.changed_tdomain() == Interval(0.,4.));
+
+    x.remove_gate(0.5);
+    CHECK(x.nb_slices() == 4);
+    CHECK(x.tracked_volume() == 13.);
+    CHECK(x.tracked_volume() == Tube(x).tracked_volume());
+
+    x.set(Interval::ALL_REALS, 0);
+    CHECK(x.tracked_volume() == Tube(x).tracked_volume());
+    CHECK(x.tracked_volume() < POS_INFINITY);
+
+    // Two consumers of the changes
+    uint64_t window_a = x.reset_changed_tdomain();
+    uint64_t window_b = 0; // never reset
+    CHECK(x.changed_tdomain(window_a).is_empty());
+    CHECK(x.changed_tdomain(window_b) == Interval(0.,4.));
+
+    x.slice(2)->set_envelope(Interval(0.5,1.));
+    CHECK(x.changed_tdomain(window_a) == Interval(2.,3.));
+    window_b = x.reset_changed_tdomain(); // the changes are lost for a
+    CHECK(x.changed_tdomain(window_a) == Interval(0.,4.));
+    CHECK(x.changed_tdomain(window_b).is_empty());
+  }
 }
 
 TEST_CASE("Interpol")